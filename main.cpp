@@ -1,5 +1,13 @@
 #include <iostream>
 #include <string>
+#include <fstream> // Saved routing data (contraction hierarchy files)
+#include <ctime> // clock() only, for the routing benchmarks
+#include <cstdio> // remove(), for the benchmark's temporary network file
+#include <thread> // Worker threads for the parallel graph algorithms (runWorkers)
+#include <mutex>
+#include <condition_variable>
+#include <atomic> // Routing snapshot publication and pin counts
+#include <chrono> // Wall-clock timing for the thread-scaling benchmarks
 
 using namespace std;
 
@@ -17,7 +25,25 @@ class TrieNode;
 class Trie;
 class GraphVertexNode;
 class GraphEdgeNode;
+class IndexedDaryHeap;
+class LazyBinaryHeap;
+class VertexIndexMap;
+class CitizenIndex;
 class Graph;
+class SearchWorkspace;
+class CSRGraph;
+class ContractionHierarchy;
+class LandmarkIndex;
+class DeltaSteppingSSSP;
+class DynamicShortestPathTree;
+class DirectionOptimizingBFS;
+class KShortestPaths;
+class RouteCache;
+class EdgeListImporter;
+class BetweennessCentrality;
+class OverlayGraph;
+class SpanningTreeBuilder;
+class MinCostFlow;
 class CitizenManagement;
 class TrafficManagement;
 class UrbanStructure;
@@ -29,6 +55,104 @@ class SmartCitySimulator;
 // tapi untuk contoh ini, kita akan coba hindari kebutuhan konversi kompleks.
 // Untuk Dijkstra, kita akan menggunakan ID integer secara langsung.
 
+const int INFINITY_DIST = 2147483647; // "Infinity" for every distance array (GraphSearchState, CSR searches)
+
+// Milliseconds of CPU time since 'start' (used by RoutingBenchmark)
+double elapsedMillis(clock_t start) {
+    return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Wall-clock milliseconds since 'start'; clock() adds up the CPU time of every thread, so the
+// thread-scaling benchmarks use this instead
+double elapsedWallMillis(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Square root by Newton's method (no <cmath>); used for straight-line distances
+double manualSqrt(double value) {
+    if (value <= 0) return 0;
+    // Scale into (1/4, 4] to get a starting guess within a factor of 2, then start above the
+    // root so the iteration decreases monotonically
+    double scaled = value, guess = 1;
+    while (scaled > 4) { scaled /= 4; guess *= 2; }
+    while (scaled <= 0.25) { scaled *= 4; guess /= 2; }
+    double root = guess * 2;
+    for (int i = 0; i < 100; ++i) {
+        double next = 0.5 * (root + value / root);
+        if (next >= root) break;
+        root = next;
+    }
+    return root;
+}
+
+// Small deterministic generator for synthetic benchmark networks (LCG, no <cstdlib> needed)
+struct SimpleRandom {
+    unsigned int state;
+
+    SimpleRandom(unsigned int seed = 12345) : state(seed) {}
+
+    unsigned int next() {
+        state = state * 1103515245u + 12345u;
+        return (state >> 8) & 0xFFFFFF;
+    }
+
+    int nextInRange(int low, int high) { // inclusive on both ends
+        return low + (int)(next() % (unsigned int)(high - low + 1));
+    }
+};
+
+// --- Worker threads for the parallel graph algorithms ---
+// A worker function gets the algorithm's shared context and its worker number (0-based).
+// Workers own disjoint parts of the output or private accumulators that the caller merges,
+// so the only synchronisation needed is joining them, or a ThreadBarrier between phases.
+typedef void (*WorkerFunction)(void* context, int worker);
+
+// Runs fn on numWorkers workers, worker 0 on the calling thread, and returns when all are done
+void runWorkers(int numWorkers, WorkerFunction fn, void* context) {
+    if (numWorkers < 1) numWorkers = 1;
+    thread* helpers = new thread[numWorkers - 1 > 0 ? numWorkers - 1 : 1];
+    for (int w = 1; w < numWorkers; ++w) helpers[w - 1] = thread(fn, context, w);
+    fn(context, 0);
+    for (int w = 1; w < numWorkers; ++w) helpers[w - 1].join();
+    delete[] helpers;
+}
+
+// Hardware threads available, at least 1 (default worker count for the parallel engines)
+int hardwareThreads() {
+    unsigned int n = thread::hardware_concurrency();
+    return n > 0 ? (int)n : 1;
+}
+
+// Reusable barrier for worker teams that run in lock-step phases: wait() returns once all
+// numWorkers threads have called it, and the barrier is ready for the next phase
+class ThreadBarrier {
+public:
+    ThreadBarrier(int workers) : numWorkers(workers < 1 ? 1 : workers), waiting(0), generation(0) {}
+
+    void wait() {
+        if (numWorkers == 1) return;
+        unique_lock<mutex> lock(guard);
+        int arrivedIn = generation;
+        if (++waiting == numWorkers) {
+            waiting = 0;
+            generation++;
+            released.notify_all();
+            return;
+        }
+        while (generation == arrivedIn) released.wait(lock);
+    }
+
+private:
+    int numWorkers;
+    int waiting;
+    int generation;
+    mutex guard;
+    condition_variable released;
+
+    ThreadBarrier(const ThreadBarrier&);
+    ThreadBarrier& operator=(const ThreadBarrier&);
+};
+
 // --- Helper structure for Dijkstra's Priority Queue (implemented as sorted linked list) ---
 struct DijkstraNode {
     int vertexID;
@@ -82,13 +206,14 @@ public:
         return count;
     }
 
-    void insertAtTail(int id, string name, string data1 = "", string data2 = "") {
+    NodeLL* insertAtTail(int id, string name, string data1 = "", string data2 = "") {
         NodeLL* newNode = new NodeLL(id, name, data1, data2);
         newNode->next = sentinel;
         newNode->prev = sentinel->prev;
         sentinel->prev->next = newNode;
         sentinel->prev = newNode;
         count++;
+        return newNode;
     }
 
     void insertAtHead(int id, string name, string data1 = "", string data2 = "") {
@@ -114,15 +239,20 @@ public:
     bool deleteNode(int id) {
         NodeLL* nodeToDelete = findNode(id);
         if (nodeToDelete) {
-            nodeToDelete->prev->next = nodeToDelete->next;
-            nodeToDelete->next->prev = nodeToDelete->prev;
-            delete nodeToDelete;
-            count--;
+            removeNode(nodeToDelete);
             return true;
         }
         return false; // Not found
     }
 
+    // O(1) unlink and delete when the caller already holds the node (e.g. from CitizenIndex)
+    void removeNode(NodeLL* node) {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        delete node;
+        count--;
+    }
+
     void displayList() const {
         if (isEmpty()) {
             cout << "List is empty." << endl;
@@ -521,14 +651,654 @@ public:
 };
 
 
+// --- AMBITIOUS FEATURE: Indexed d-ary Heap (real Priority Queue with decrease-key) ---
+// Keys are dense integer handles 0..capacity-1 (e.g. GraphVertexNode::index), priorities are ints.
+// position[] maps each key to its slot in the heap, so decreaseKey is O(log_d n) instead of
+// the O(n) walk done by ManualLinkedList::sortedInsertDijkstra.
+class IndexedDaryHeap {
+public:
+    int arity;      // Children per node (2 = binary heap, 4 is a good default for Dijkstra)
+    int capacity;   // Number of distinct keys
+    int size;
+    int* heapKeys;  // Heap slot -> key
+    int* heapPrio;  // Heap slot -> priority
+    int* position;  // Key -> heap slot, -1 if the key is not in the heap
+
+    IndexedDaryHeap(int cap, int d = 4) : arity(d < 2 ? 2 : d), capacity(cap), size(0) {
+        heapKeys = new int[cap > 0 ? cap : 1];
+        heapPrio = new int[cap > 0 ? cap : 1];
+        position = new int[cap > 0 ? cap : 1];
+        for (int i = 0; i < cap; ++i) position[i] = -1;
+    }
+
+    ~IndexedDaryHeap() {
+        delete[] heapKeys;
+        delete[] heapPrio;
+        delete[] position;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    bool contains(int key) const {
+        return position[key] != -1;
+    }
+
+    int topKey() const {
+        return heapKeys[0];
+    }
+
+    int topPriority() const {
+        return heapPrio[0];
+    }
+
+    void push(int key, int prio) {
+        int slot = size++;
+        heapKeys[slot] = key;
+        heapPrio[slot] = prio;
+        position[key] = slot;
+        siftUp(slot);
+    }
+
+    // Lowers the priority of a key already in the heap. Returns false if prio is not an improvement.
+    bool decreaseKey(int key, int prio) {
+        int slot = position[key];
+        if (slot == -1 || prio >= heapPrio[slot]) return false;
+        heapPrio[slot] = prio;
+        siftUp(slot);
+        return true;
+    }
+
+    // Dijkstra-style relax: insert if absent, otherwise decrease
+    void pushOrDecrease(int key, int prio) {
+        if (position[key] == -1) push(key, prio);
+        else decreaseKey(key, prio);
+    }
+
+    // Sets a key's priority in either direction (inserts if absent)
+    void update(int key, int prio) {
+        int slot = position[key];
+        if (slot == -1) {
+            push(key, prio);
+            return;
+        }
+        int old = heapPrio[slot];
+        heapPrio[slot] = prio;
+        if (prio < old) siftUp(slot);
+        else siftDown(slot);
+    }
+
+    int pop() { // Removes and returns the key with the smallest priority
+        int minKey = heapKeys[0];
+        position[minKey] = -1;
+        size--;
+        if (size > 0) {
+            heapKeys[0] = heapKeys[size];
+            heapPrio[0] = heapPrio[size];
+            position[heapKeys[0]] = 0;
+            siftDown(0);
+        }
+        return minKey;
+    }
+
+    void clear() { // O(size), not O(capacity), so the heap can be reused between queries
+        for (int i = 0; i < size; ++i) position[heapKeys[i]] = -1;
+        size = 0;
+    }
+
+private:
+    void siftUp(int slot) {
+        int key = heapKeys[slot];
+        int prio = heapPrio[slot];
+        while (slot > 0) {
+            int parent = (slot - 1) / arity;
+            if (heapPrio[parent] <= prio) break;
+            heapKeys[slot] = heapKeys[parent];
+            heapPrio[slot] = heapPrio[parent];
+            position[heapKeys[slot]] = slot;
+            slot = parent;
+        }
+        heapKeys[slot] = key;
+        heapPrio[slot] = prio;
+        position[key] = slot;
+    }
+
+    void siftDown(int slot) {
+        int key = heapKeys[slot];
+        int prio = heapPrio[slot];
+        while (true) {
+            int firstChild = slot * arity + 1;
+            if (firstChild >= size) break;
+            int lastChild = firstChild + arity;
+            if (lastChild > size) lastChild = size;
+            int best = firstChild;
+            for (int c = firstChild + 1; c < lastChild; ++c) {
+                if (heapPrio[c] < heapPrio[best]) best = c;
+            }
+            if (heapPrio[best] >= prio) break;
+            heapKeys[slot] = heapKeys[best];
+            heapPrio[slot] = heapPrio[best];
+            position[heapKeys[slot]] = slot;
+            slot = best;
+        }
+        heapKeys[slot] = key;
+        heapPrio[slot] = prio;
+        position[key] = slot;
+    }
+};
+
+// --- Lazy-deletion Binary Heap ---
+// No position index: a relax simply pushes a new (key, priority) entry and stale entries are
+// skipped by the caller when popped (same idea as the duplicate handling in the sorted-list PQ).
+// Useful when keys are not dense or when several searches share one key space.
+struct HeapEntry {
+    int key;
+    int priority;
+};
+
+class LazyBinaryHeap {
+public:
+    HeapEntry* entries;
+    int size;
+    int capacity;
+
+    LazyBinaryHeap(int initialCapacity = 64) : size(0), capacity(initialCapacity < 1 ? 1 : initialCapacity) {
+        entries = new HeapEntry[capacity];
+    }
+
+    ~LazyBinaryHeap() {
+        delete[] entries;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    HeapEntry top() const {
+        return entries[0];
+    }
+
+    void push(int key, int prio) {
+        if (size == capacity) { // Grow by doubling
+            HeapEntry* bigger = new HeapEntry[capacity * 2];
+            for (int i = 0; i < size; ++i) bigger[i] = entries[i];
+            delete[] entries;
+            entries = bigger;
+            capacity *= 2;
+        }
+        int slot = size++;
+        while (slot > 0) {
+            int parent = (slot - 1) / 2;
+            if (entries[parent].priority <= prio) break;
+            entries[slot] = entries[parent];
+            slot = parent;
+        }
+        entries[slot].key = key;
+        entries[slot].priority = prio;
+    }
+
+    HeapEntry pop() {
+        HeapEntry minEntry = entries[0];
+        size--;
+        if (size > 0) {
+            HeapEntry last = entries[size];
+            int slot = 0;
+            while (true) {
+                int child = slot * 2 + 1;
+                if (child >= size) break;
+                if (child + 1 < size && entries[child + 1].priority < entries[child].priority) child++;
+                if (entries[child].priority >= last.priority) break;
+                entries[slot] = entries[child];
+                slot = child;
+            }
+            entries[slot] = last;
+        }
+        return minEntry;
+    }
+
+    void clear() {
+        size = 0;
+    }
+};
+
+
+// --- Growable int array (used where a result size is not known up front) ---
+class IntList {
+public:
+    int* data;
+    int size;
+    int capacity;
+
+    IntList(int initialCapacity = 16) : size(0), capacity(initialCapacity < 1 ? 1 : initialCapacity) {
+        data = new int[capacity];
+    }
+
+    ~IntList() {
+        delete[] data;
+    }
+
+    void push(int value) {
+        if (size == capacity) {
+            int* bigger = new int[capacity * 2];
+            for (int i = 0; i < size; ++i) bigger[i] = data[i];
+            delete[] data;
+            data = bigger;
+            capacity *= 2;
+        }
+        data[size++] = value;
+    }
+
+    void clear() {
+        size = 0;
+    }
+};
+
+// --- Open-addressing hash index: external vertex ID -> dense vertex index ---
+// Linear probing over a power-of-two table kept at most half full. Values are dense indices
+// (>= 0), so -1 marks an empty slot and any int is a valid ID. Vertices are never removed,
+// so no tombstones are needed.
+class VertexIndexMap {
+public:
+    int* slotKeys;
+    int* slotValues;
+    int tableSize; // Always a power of two
+    int count;
+
+    VertexIndexMap(int expectedKeys = 8) : count(0) {
+        tableSize = 16;
+        while (tableSize < expectedKeys * 2) tableSize *= 2;
+        allocate(tableSize);
+    }
+
+    ~VertexIndexMap() {
+        delete[] slotKeys;
+        delete[] slotValues;
+    }
+
+    int find(int key) const { // -1 if the key is not present
+        int mask = tableSize - 1;
+        int slot = hashSlot(key, mask);
+        while (slotValues[slot] != -1) {
+            if (slotKeys[slot] == key) return slotValues[slot];
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+
+    void insert(int key, int value) { // Overwrites the value if the key already exists
+        if ((count + 1) * 2 > tableSize) grow();
+        int mask = tableSize - 1;
+        int slot = hashSlot(key, mask);
+        while (slotValues[slot] != -1) {
+            if (slotKeys[slot] == key) {
+                slotValues[slot] = value;
+                return;
+            }
+            slot = (slot + 1) & mask;
+        }
+        slotKeys[slot] = key;
+        slotValues[slot] = value;
+        count++;
+    }
+
+    void clear() {
+        for (int i = 0; i < tableSize; ++i) slotValues[i] = -1;
+        count = 0;
+    }
+
+    void reserve(int expectedKeys) {
+        if (expectedKeys * 2 <= tableSize) return;
+        int newSize = tableSize;
+        while (newSize < expectedKeys * 2) newSize *= 2;
+        rehash(newSize);
+    }
+
+private:
+    static int hashSlot(int key, int mask) {
+        unsigned int h = (unsigned int)key * 2654435769u; // Fibonacci hashing
+        h ^= h >> 16;
+        return (int)(h & (unsigned int)mask);
+    }
+
+    void allocate(int size) {
+        slotKeys = new int[size];
+        slotValues = new int[size];
+        for (int i = 0; i < size; ++i) slotValues[i] = -1;
+    }
+
+    void grow() {
+        rehash(tableSize * 2);
+    }
+
+    void rehash(int newSize) {
+        int* oldKeys = slotKeys;
+        int* oldValues = slotValues;
+        int oldSize = tableSize;
+        tableSize = newSize;
+        allocate(newSize);
+        count = 0;
+        for (int i = 0; i < oldSize; ++i) {
+            if (oldValues[i] != -1) insert(oldKeys[i], oldValues[i]);
+        }
+        delete[] oldKeys;
+        delete[] oldValues;
+    }
+};
+
+// --- AMBITIOUS FEATURE: Robin Hood hash index from citizen ID to its registry node ---
+// ManualLinkedList::findNode walks the whole list, so every lookup in a registry of millions
+// is O(n) and a bulk load is quadratic. This open-addressing table maps an ID straight to its
+// NodeLL while the list keeps the insertion order for display. Robin Hood placement (an entry
+// takes the slot of any resident that sits closer to its home slot) keeps probe sequences
+// short at high load, lets find() stop as soon as it passes where the key would have been, and
+// allows deletion by shifting the following run back one slot instead of leaving tombstones.
+class CitizenIndex {
+public:
+    int* slotKeys;
+    NodeLL** slotNodes; // NULL marks an empty slot
+    int tableSize;      // Always a power of two
+    int count;
+
+    CitizenIndex(int expectedKeys = 8) : count(0) {
+        tableSize = 16;
+        while (tableSize * 4 < expectedKeys * 5) tableSize *= 2;
+        allocate(tableSize);
+    }
+
+    ~CitizenIndex() {
+        delete[] slotKeys;
+        delete[] slotNodes;
+    }
+
+    NodeLL* find(int key) const { // NULL if the key is not present
+        int slot = findSlot(key);
+        return slot == -1 ? NULL : slotNodes[slot];
+    }
+
+    void insert(int key, NodeLL* node) { // Overwrites the node if the key already exists
+        if ((count + 1) * 5 > tableSize * 4) grow(); // Keep the load factor at or below 0.8
+        int mask = tableSize - 1;
+        int slot = hashSlot(key, mask);
+        int distance = 0;
+        while (slotNodes[slot]) {
+            if (slotKeys[slot] == key) {
+                slotNodes[slot] = node;
+                return;
+            }
+            int residentDistance = probeDistance(slot);
+            if (residentDistance < distance) { // Take the slot, carry the resident onwards
+                int displacedKey = slotKeys[slot];
+                NodeLL* displacedNode = slotNodes[slot];
+                slotKeys[slot] = key;
+                slotNodes[slot] = node;
+                key = displacedKey;
+                node = displacedNode;
+                distance = residentDistance;
+            }
+            slot = (slot + 1) & mask;
+            distance++;
+        }
+        slotKeys[slot] = key;
+        slotNodes[slot] = node;
+        count++;
+    }
+
+    bool remove(int key) {
+        int slot = findSlot(key);
+        if (slot == -1) return false;
+        int mask = tableSize - 1;
+        int next = (slot + 1) & mask;
+        while (slotNodes[next] && probeDistance(next) > 0) { // Backward-shift deletion
+            slotKeys[slot] = slotKeys[next];
+            slotNodes[slot] = slotNodes[next];
+            slot = next;
+            next = (next + 1) & mask;
+        }
+        slotNodes[slot] = NULL;
+        count--;
+        return true;
+    }
+
+    void reserve(int expectedKeys) {
+        if (expectedKeys * 5 <= tableSize * 4) return;
+        int newSize = tableSize;
+        while (newSize * 4 < expectedKeys * 5) newSize *= 2;
+        rehash(newSize);
+    }
+
+    int longestProbe() const { // For diagnostics: worst distance of any entry from its home slot
+        int longest = 0;
+        for (int i = 0; i < tableSize; ++i) {
+            if (slotNodes[i] && probeDistance(i) > longest) longest = probeDistance(i);
+        }
+        return longest;
+    }
+
+private:
+    CitizenIndex(const CitizenIndex&);
+    CitizenIndex& operator=(const CitizenIndex&);
+
+    static int hashSlot(int key, int mask) {
+        unsigned int h = (unsigned int)key * 2654435769u; // Fibonacci hashing, as in VertexIndexMap
+        h ^= h >> 16;
+        return (int)(h & (unsigned int)mask);
+    }
+
+    int probeDistance(int slot) const {
+        int mask = tableSize - 1;
+        return (slot - hashSlot(slotKeys[slot], mask)) & mask;
+    }
+
+    int findSlot(int key) const { // -1 if the key is not present
+        int mask = tableSize - 1;
+        int slot = hashSlot(key, mask);
+        for (int distance = 0; slotNodes[slot]; ++distance) {
+            if (slotKeys[slot] == key) return slot;
+            if (probeDistance(slot) < distance) return -1; // The key would have displaced this entry
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+
+    void allocate(int size) {
+        slotKeys = new int[size];
+        slotNodes = new NodeLL*[size];
+        for (int i = 0; i < size; ++i) slotNodes[i] = NULL;
+    }
+
+    void grow() {
+        rehash(tableSize * 2);
+    }
+
+    void rehash(int newSize) {
+        int* oldKeys = slotKeys;
+        NodeLL** oldNodes = slotNodes;
+        int oldSize = tableSize;
+        tableSize = newSize;
+        allocate(newSize);
+        count = 0;
+        for (int i = 0; i < oldSize; ++i) {
+            if (oldNodes[i]) insert(oldKeys[i], oldNodes[i]);
+        }
+        delete[] oldKeys;
+        delete[] oldNodes;
+    }
+};
+
+// --- AMBITIOUS FEATURE: Time-dependent travel times (shared profile pool) ---
+// A profile is a periodic piecewise-linear function over the day: breakpoints (minute, travel
+// time) with linear interpolation in between and wrap-around from the last breakpoint to the
+// first one of the next day. Roads of the same class and length usually share a profile, so
+// every distinct breakpoint sequence is stored once and edges only keep its id. Profiles must
+// be FIFO (no segment falls faster than one minute per minute), otherwise waiting could pay
+// off and time-dependent Dijkstra would no longer be exact; addProfile rejects those.
+const int MINUTES_PER_DAY = 1440;
+
+class TravelTimeProfilePool {
+public:
+    IntList profileStart;  // Breakpoints of profile p are [profileStart[p], profileStart[p + 1])
+    IntList pointMinutes;  // Strictly increasing within a profile, in [0, MINUTES_PER_DAY)
+    IntList pointValues;   // Travel time at that minute
+    IntList profileMin;    // Smallest travel time of each profile (for admissible A* bounds)
+    IntList profileHash;
+    int numProfiles;
+    int lookups;           // addProfile calls, to show how much deduplication saves
+
+    TravelTimeProfilePool() : numProfiles(0), lookups(0), slots(NULL), tableSize(0) {
+        profileStart.push(0);
+        allocateSlots(64);
+    }
+
+    ~TravelTimeProfilePool() {
+        delete[] slots;
+    }
+
+    // Returns the id of an identical existing profile or of the newly stored one; -1 if the
+    // breakpoints are unsorted, out of range or not FIFO
+    int addProfile(const int* minutes, const int* values, int count) {
+        lookups++;
+        if (count <= 0) return -1;
+        for (int i = 0; i < count; ++i) {
+            if (minutes[i] < 0 || minutes[i] >= MINUTES_PER_DAY || values[i] < 0) return -1;
+            if (i > 0 && minutes[i] <= minutes[i - 1]) return -1;
+            int next = (i + 1) % count;
+            int span = (next == 0 ? minutes[0] + MINUTES_PER_DAY : minutes[next]) - minutes[i];
+            if (count > 1 && values[next] - values[i] < -span) return -1;
+        }
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < count; ++i) {
+            h = (h ^ (unsigned int)minutes[i]) * 16777619u;
+            h = (h ^ (unsigned int)values[i]) * 16777619u;
+        }
+        int mask = tableSize - 1;
+        int slot = (int)(h & (unsigned int)mask);
+        while (slots[slot] != -1) {
+            int p = slots[slot];
+            if ((unsigned int)profileHash.data[p] == h && sameProfile(p, minutes, values, count)) return p;
+            slot = (slot + 1) & mask;
+        }
+
+        int minValue = values[0];
+        for (int i = 0; i < count; ++i) {
+            pointMinutes.push(minutes[i]);
+            pointValues.push(values[i]);
+            if (values[i] < minValue) minValue = values[i];
+        }
+        profileStart.push(pointMinutes.size);
+        profileMin.push(minValue);
+        profileHash.push((int)h);
+        slots[slot] = numProfiles;
+        numProfiles++;
+        if (numProfiles * 2 > tableSize) rehash(tableSize * 2);
+        return numProfiles - 1;
+    }
+
+    // Travel time when entering the road at 'departure' (any minute, taken modulo one day)
+    int travelTime(int profile, int departure) const {
+        int first = profileStart.data[profile];
+        int last = profileStart.data[profile + 1] - 1;
+        int t = departure % MINUTES_PER_DAY;
+        if (t < 0) t += MINUTES_PER_DAY;
+        if (first == last) return pointValues.data[first];
+
+        // Binary search for the last breakpoint at or before t (wrapping to the previous day's last one)
+        int lo = first, hi = last, at = -1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (pointMinutes.data[mid] <= t) {
+                at = mid;
+                lo = mid + 1;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        int t0, v0, t1, v1;
+        if (at == -1) { // Before the first breakpoint: segment from yesterday's last one
+            t0 = pointMinutes.data[last] - MINUTES_PER_DAY;
+            v0 = pointValues.data[last];
+            t1 = pointMinutes.data[first];
+            v1 = pointValues.data[first];
+        } else if (at == last) {
+            t0 = pointMinutes.data[last];
+            v0 = pointValues.data[last];
+            t1 = pointMinutes.data[first] + MINUTES_PER_DAY;
+            v1 = pointValues.data[first];
+        } else {
+            t0 = pointMinutes.data[at];
+            v0 = pointValues.data[at];
+            t1 = pointMinutes.data[at + 1];
+            v1 = pointValues.data[at + 1];
+        }
+        // Floor division keeps departure + travelTime non-decreasing (FIFO) after rounding
+        int numerator = (v1 - v0) * (t - t0);
+        int span = t1 - t0;
+        int step = numerator / span;
+        if (numerator < 0 && numerator % span != 0) step--;
+        return v0 + step;
+    }
+
+    int minTravelTime(int profile) const {
+        return profileMin.data[profile];
+    }
+
+    long long memoryBytes() const {
+        return (long long)sizeof(int) * (profileStart.capacity + pointMinutes.capacity + pointValues.capacity +
+                                         profileMin.capacity + profileHash.capacity + tableSize);
+    }
+
+private:
+    int* slots; // Open addressing over profile ids, -1 = empty
+    int tableSize;
+
+    bool sameProfile(int p, const int* minutes, const int* values, int count) const {
+        int first = profileStart.data[p];
+        if (profileStart.data[p + 1] - first != count) return false;
+        for (int i = 0; i < count; ++i) {
+            if (pointMinutes.data[first + i] != minutes[i] || pointValues.data[first + i] != values[i]) return false;
+        }
+        return true;
+    }
+
+    void allocateSlots(int size) {
+        tableSize = size;
+        slots = new int[size];
+        for (int i = 0; i < size; ++i) slots[i] = -1;
+    }
+
+    void rehash(int newSize) {
+        delete[] slots;
+        allocateSlots(newSize);
+        int mask = tableSize - 1;
+        for (int p = 0; p < numProfiles; ++p) {
+            int slot = (int)((unsigned int)profileHash.data[p] & (unsigned int)mask);
+            while (slots[slot] != -1) slot = (slot + 1) & mask;
+            slots[slot] = p;
+        }
+    }
+};
+
+
 // --- CORE IMPLEMENTATION: Graph (Adjacency List using ManualLinkedList) ---
+const int DEFAULT_ROAD_CAPACITY = 1000; // People a road can carry in one evacuation plan unless set otherwise
+
 // Edge node for adjacency list
 struct GraphEdgeNode {
     int toVertexID;
     int weight;
+    int profileId; // TravelTimeProfilePool id for time-dependent roads, -1 = constant 'weight'
+    int capacity;  // Used by the evacuation planner (MinCostFlow); 0 = closed to evacuation traffic
     GraphEdgeNode* next;
 
-    GraphEdgeNode(int to, int w) : toVertexID(to), weight(w), next(NULL) {}
+    GraphEdgeNode(int to, int w) : toVertexID(to), weight(w), profileId(-1), capacity(DEFAULT_ROAD_CAPACITY), next(NULL) {}
 };
 
 // Vertex node for graph
@@ -536,14 +1306,16 @@ struct GraphVertexNode {
     int id;
     string name; // e.g., Intersection Name, Location Name
     GraphEdgeNode* adjListHead; // Head of the adjacency list (linked list of edges)
+    GraphEdgeNode* inListHead;  // Reverse adjacency: incoming edges, toVertexID holds the edge's tail
     GraphVertexNode* nextVertex; // To link vertices in the graph's main list of vertices
+    int index; // Dense 0..N-1 position, assigned by Graph::addVertex (used as heap key)
 
-    // For Dijkstra
-    int distFromSource;
-    bool visited;
+    // Optional planar position (e.g. projected meters), used by the A* heuristic
+    double x;
+    double y;
+    bool hasCoordinates;
 
-
-    GraphVertexNode(int i, string n) : id(i), name(n), adjListHead(NULL), nextVertex(NULL), distFromSource(2147483647), visited(false) {} // 2147483647 ~ infinity
+    GraphVertexNode(int i, string n) : id(i), name(n), adjListHead(NULL), inListHead(NULL), nextVertex(NULL), index(-1), x(0), y(0), hasCoordinates(false) {}
 
     ~GraphVertexNode() {
         GraphEdgeNode* currentEdge = adjListHead;
@@ -552,15 +1324,69 @@ struct GraphVertexNode {
             currentEdge = currentEdge->next;
             delete tempEdge;
         }
+        currentEdge = inListHead;
+        while (currentEdge) {
+            GraphEdgeNode* tempEdge = currentEdge;
+            currentEdge = currentEdge->next;
+            delete tempEdge;
+        }
+    }
+};
+
+// Per-query scratch for the Graph traversals, indexed by GraphVertexNode::index. It used to
+// live inside the vertices (distFromSource/visited), which meant a query wrote into the shared
+// graph; now each query brings its own, so the vertices are only written by graph edits.
+struct GraphSearchState {
+    int capacity;
+    int* dist;     // INFINITY_DIST when not reached
+    bool* visited;
+
+    GraphSearchState(int n = 0) : capacity(0), dist(NULL), visited(NULL) { reset(n); }
+
+    ~GraphSearchState() {
+        delete[] dist;
+        delete[] visited;
+    }
+
+    // Sizes the arrays for an n-vertex graph (growing only) and marks everything unreached
+    void reset(int n) {
+        if (n > capacity) {
+            delete[] dist;
+            delete[] visited;
+            capacity = n;
+            dist = new int[n];
+            visited = new bool[n];
+        }
+        for (int i = 0; i < n; ++i) {
+            dist[i] = INFINITY_DIST;
+            visited[i] = false;
+        }
     }
+
+private:
+    GraphSearchState(const GraphSearchState&);
+    GraphSearchState& operator=(const GraphSearchState&);
+};
+
+// Which frontier structure Graph::computeDijkstra should use
+enum PriorityQueueKind {
+    PQ_SORTED_LIST,       // Original ManualLinkedList::sortedInsertDijkstra, O(n) per insert
+    PQ_INDEXED_DARY_HEAP, // IndexedDaryHeap with decrease-key (default)
+    PQ_LAZY_BINARY_HEAP   // LazyBinaryHeap, stale entries skipped on pop
 };
 
 class Graph {
 public:
     GraphVertexNode* vertexListHead; // Head of the linked list of all vertices in the graph
     int numVertices;
+    GraphVertexNode** vertexByIndex; // Dense index -> vertex node
+    int vertexCapacity;
+    int numEdges;
+    int version; // Bumped on every mutation, so snapshots (CSRGraph) can tell they are stale
+    VertexIndexMap idIndex; // External vertex ID -> dense index, maintained by addVertex
+    TravelTimeProfilePool profiles; // Shared rush-hour profiles referenced by GraphEdgeNode::profileId
 
-    Graph() : vertexListHead(NULL), numVertices(0) {}
+    Graph() : vertexListHead(NULL), numVertices(0), vertexByIndex(NULL), vertexCapacity(0), numEdges(0), version(0) {}
 
     ~Graph() {
         GraphVertexNode* currentVertex = vertexListHead;
@@ -569,17 +1395,24 @@ public:
             currentVertex = currentVertex->nextVertex;
             delete tempVertex; // This will call ~GraphVertexNode() which deletes its adj list
         }
+        delete[] vertexByIndex;
     }
 
-    GraphVertexNode* findVertex(int id) {
-        GraphVertexNode* current = vertexListHead;
-        while (current) {
-            if (current->id == id) {
-                return current;
-            }
-            current = current->nextVertex;
+    GraphVertexNode* findVertex(int id) { // O(1) through the hash index
+        int index = idIndex.find(id);
+        return index == -1 ? NULL : vertexByIndex[index];
+    }
+
+    // Presizes the dense index table and the ID hash index for bulk loads
+    void reserveVertices(int expectedVertices) {
+        if (expectedVertices > vertexCapacity) {
+            GraphVertexNode** bigger = new GraphVertexNode*[expectedVertices];
+            for (int i = 0; i < numVertices; ++i) bigger[i] = vertexByIndex[i];
+            delete[] vertexByIndex;
+            vertexByIndex = bigger;
+            vertexCapacity = expectedVertices;
         }
-        return NULL;
+        idIndex.reserve(expectedVertices);
     }
 
     void addVertex(int id, string name) {
@@ -590,7 +1423,32 @@ public:
         GraphVertexNode* newNode = new GraphVertexNode(id, name);
         newNode->nextVertex = vertexListHead; // Add to head of vertex list
         vertexListHead = newNode;
+
+        if (numVertices == vertexCapacity) { // Grow the dense index table by doubling
+            int newCapacity = vertexCapacity == 0 ? 16 : vertexCapacity * 2;
+            GraphVertexNode** bigger = new GraphVertexNode*[newCapacity];
+            for (int i = 0; i < numVertices; ++i) bigger[i] = vertexByIndex[i];
+            delete[] vertexByIndex;
+            vertexByIndex = bigger;
+            vertexCapacity = newCapacity;
+        }
+        newNode->index = numVertices;
+        vertexByIndex[numVertices] = newNode;
+        idIndex.insert(id, numVertices);
         numVertices++;
+        version++;
+    }
+
+    void addVertex(int id, string name, double x, double y) {
+        if (findVertex(id)) {
+            cout << "Error: Vertex with ID " << id << " already exists." << endl;
+            return;
+        }
+        addVertex(id, name);
+        GraphVertexNode* newNode = findVertex(id);
+        newNode->x = x;
+        newNode->y = y;
+        newNode->hasCoordinates = true;
     }
 
     void addEdge(int fromID, int toID, int weight) {
@@ -606,16 +1464,109 @@ public:
         GraphEdgeNode* newEdge = new GraphEdgeNode(toID, weight);
         newEdge->next = fromVertex->adjListHead;
         fromVertex->adjListHead = newEdge;
-
-        // For an undirected graph, add the reverse edge too
-        // GraphEdgeNode* reverseEdge = new GraphEdgeNode(fromID, weight);
-        // reverseEdge->next = toVertex->adjListHead;
-        // toVertex->adjListHead = reverseEdge;
+        numEdges++;
+        version++;
+
+        // Mirror it in the reverse adjacency of toID (the road stays one-way;
+        // two-way roads are still added as two edges)
+        GraphEdgeNode* reverseEdge = new GraphEdgeNode(fromID, weight);
+        reverseEdge->next = toVertex->inListHead;
+        toVertex->inListHead = reverseEdge;
     }
 
-    void displayGraph() {
-        cout << "Graph Adjacency List:" << endl;
-        GraphVertexNode* currentVertex = vertexListHead;
+    // Changes the travel time of road fromID -> toID (the most recently added one if there are
+    // parallel roads) and its reverse-adjacency mirror. The previous weight is stored in
+    // *oldWeight so incremental consumers (DynamicShortestPathTree) can repair themselves.
+    // Negative travel times are refused: every search engine assumes non-negative weights.
+    bool updateEdgeWeight(int fromID, int toID, int newWeight, int* oldWeight = NULL) {
+        GraphVertexNode* fromVertex = findVertex(fromID);
+        GraphVertexNode* toVertex = findVertex(toID);
+        if (!fromVertex || !toVertex || newWeight < 0) return false;
+
+        GraphEdgeNode* edge = fromVertex->adjListHead;
+        while (edge && edge->toVertexID != toID) edge = edge->next;
+        if (!edge) return false;
+        int previous = edge->weight;
+        edge->weight = newWeight;
+
+        GraphEdgeNode* reverseEdge = toVertex->inListHead;
+        while (reverseEdge && (reverseEdge->toVertexID != fromID || reverseEdge->weight != previous)) {
+            reverseEdge = reverseEdge->next;
+        }
+        if (reverseEdge) reverseEdge->weight = newWeight;
+
+        if (oldWeight) *oldWeight = previous;
+        version++;
+        return true;
+    }
+
+    // Attaches a profile from 'profiles' to road fromID -> toID (same edge updateEdgeWeight
+    // picks); -1 makes the road constant again
+    bool setEdgeProfile(int fromID, int toID, int profileId) {
+        GraphVertexNode* fromVertex = findVertex(fromID);
+        GraphVertexNode* toVertex = findVertex(toID);
+        if (!fromVertex || !toVertex || profileId < -1 || profileId >= profiles.numProfiles) return false;
+        GraphEdgeNode* edge = fromVertex->adjListHead;
+        while (edge && edge->toVertexID != toID) edge = edge->next;
+        if (!edge) return false;
+        GraphEdgeNode* reverseEdge = toVertex->inListHead;
+        while (reverseEdge && (reverseEdge->toVertexID != fromID || reverseEdge->weight != edge->weight || reverseEdge->profileId != edge->profileId)) {
+            reverseEdge = reverseEdge->next;
+        }
+        edge->profileId = profileId;
+        if (reverseEdge) reverseEdge->profileId = profileId;
+        version++;
+        return true;
+    }
+
+    // Capacity of road fromID -> toID (same edge updateEdgeWeight picks) and its mirror
+    bool setEdgeCapacity(int fromID, int toID, int capacity) {
+        GraphVertexNode* fromVertex = findVertex(fromID);
+        GraphVertexNode* toVertex = findVertex(toID);
+        if (!fromVertex || !toVertex || capacity < 0) return false;
+        GraphEdgeNode* edge = fromVertex->adjListHead;
+        while (edge && edge->toVertexID != toID) edge = edge->next;
+        if (!edge) return false;
+        GraphEdgeNode* reverseEdge = toVertex->inListHead;
+        while (reverseEdge && (reverseEdge->toVertexID != fromID || reverseEdge->weight != edge->weight || reverseEdge->capacity != edge->capacity)) {
+            reverseEdge = reverseEdge->next;
+        }
+        edge->capacity = capacity;
+        if (reverseEdge) reverseEdge->capacity = capacity;
+        version++;
+        return true;
+    }
+
+    // Road closure: unlinks road fromID -> toID (same edge updateEdgeWeight picks) and its mirror
+    bool removeEdge(int fromID, int toID) {
+        GraphVertexNode* fromVertex = findVertex(fromID);
+        GraphVertexNode* toVertex = findVertex(toID);
+        if (!fromVertex || !toVertex) return false;
+
+        GraphEdgeNode** link = &fromVertex->adjListHead;
+        while (*link && (*link)->toVertexID != toID) link = &(*link)->next;
+        if (!*link) return false;
+        GraphEdgeNode* edge = *link;
+        *link = edge->next;
+
+        GraphEdgeNode** reverseLink = &toVertex->inListHead;
+        while (*reverseLink && ((*reverseLink)->toVertexID != fromID || (*reverseLink)->weight != edge->weight)) {
+            reverseLink = &(*reverseLink)->next;
+        }
+        if (*reverseLink) {
+            GraphEdgeNode* reverseEdge = *reverseLink;
+            *reverseLink = reverseEdge->next;
+            delete reverseEdge;
+        }
+        delete edge;
+        numEdges--;
+        version++;
+        return true;
+    }
+
+    void displayGraph() {
+        cout << "Graph Adjacency List:" << endl;
+        GraphVertexNode* currentVertex = vertexListHead;
         if (!currentVertex) {
             cout << "Graph is empty." << endl;
             return;
@@ -643,17 +1594,11 @@ public:
             return;
         }
 
-        // Manual visited tracking (could be bool array if IDs are 0 to N-1, or use map/set if allowed)
-        // For this pure C++ version, we'll add a 'visited' flag to GraphVertexNode
-        // Reset visited flags for all nodes
-        GraphVertexNode* tempV = vertexListHead;
-        while(tempV) { tempV->visited = false; tempV = tempV->nextVertex; }
-
-
+        GraphSearchState state(numVertices);
         ManualQueue q; // Our own queue
         cout << "BFS starting from vertex " << startVertexID << ": ";
 
-        startNode->visited = true;
+        state.visited[startNode->index] = true;
         q.enqueue(to_string(startVertexID), "VERTEX"); // Store ID as string for queue data
 
         while (!q.isEmpty()) {
@@ -667,8 +1612,8 @@ public:
             GraphEdgeNode* edge = u->adjListHead;
             while (edge) {
                 GraphVertexNode* v = findVertex(edge->toVertexID);
-                if (v && !v->visited) {
-                    v->visited = true;
+                if (v && !state.visited[v->index]) {
+                    state.visited[v->index] = true;
                     q.enqueue(to_string(v->id), "VERTEX");
                 }
                 edge = edge->next;
@@ -678,59 +1623,119 @@ public:
     }
 
     // --- AMBITIOUS FEATURE: Depth-First Search (DFS) ---
-    void DFSUtil(GraphVertexNode* v, bool visited[]) { // visited array needs to be sized by max vertex ID or use map
-        // For pure C++, using the node's visited flag
-        v->visited = true;
-        cout << v->id << " ";
-
-        GraphEdgeNode* edge = v->adjListHead;
-        while(edge) {
-            GraphVertexNode* adjV = findVertex(edge->toVertexID);
-            if(adjV && !adjV->visited) {
-                DFSUtil(adjV, visited); // Recursive call
-            }
-            edge = edge->next;
-        }
-    }
-
+    // Iterative DFS: an explicit stack of (vertex, next edge to try) frames replaces the
+    // recursion, so long chain-like road graphs cannot overflow the call stack. Each vertex is
+    // pushed at most once, so both arrays are sized numVertices up front. Visit order is the
+    // same as the recursive version.
     void DFS(int startVertexID) {
         GraphVertexNode* startNode = findVertex(startVertexID);
         if (!startNode) {
             cout << "DFS Error: Start vertex " << startVertexID << " not found." << endl;
             return;
         }
-        // Reset visited flags
-        GraphVertexNode* tempV = vertexListHead;
-        while(tempV) { tempV->visited = false; tempV = tempV->nextVertex; }
-
+        GraphSearchState state(numVertices);
+        GraphVertexNode** stackVertex = new GraphVertexNode*[numVertices];
+        GraphEdgeNode** stackEdge = new GraphEdgeNode*[numVertices];
+        int top = 0;
         cout << "DFS starting from vertex " << startVertexID << ": ";
-        DFSUtil(startNode, NULL); // Visited array not strictly needed if using node flags
+        state.visited[startNode->index] = true;
+        cout << startNode->id << " ";
+        stackVertex[top] = startNode;
+        stackEdge[top++] = startNode->adjListHead;
+        while (top > 0) {
+            GraphEdgeNode* edge = stackEdge[top - 1];
+            if (!edge) {
+                top--;
+                continue;
+            }
+            stackEdge[top - 1] = edge->next;
+            GraphVertexNode* adjV = findVertex(edge->toVertexID);
+            if (adjV && !state.visited[adjV->index]) {
+                state.visited[adjV->index] = true;
+                cout << adjV->id << " ";
+                stackVertex[top] = adjV;
+                stackEdge[top++] = adjV->adjListHead;
+            }
+        }
         cout << endl;
+        delete[] stackVertex;
+        delete[] stackEdge;
     }
 
-    // --- AMBITIOUS FEATURE: Dijkstra's Algorithm (using sorted linked list as PQ) ---
-    void Dijkstra(int startVertexID) {
+    // --- AMBITIOUS FEATURE: Dijkstra's Algorithm (indexed d-ary heap as PQ) ---
+    // Fills state.dist (by dense index) for every vertex. Returns false if the start vertex does not exist.
+    bool computeDijkstra(int startVertexID, GraphSearchState& state, PriorityQueueKind pqKind = PQ_INDEXED_DARY_HEAP) {
         GraphVertexNode* startNode = findVertex(startVertexID);
-        if (!startNode) {
-            cout << "Dijkstra Error: Start vertex " << startVertexID << " not found." << endl;
-            return;
+        if (!startNode) return false;
+
+        state.reset(numVertices);
+        state.dist[startNode->index] = 0;
+
+        if (pqKind == PQ_SORTED_LIST) {
+            runDijkstraSortedList(startNode, state);
+        } else if (pqKind == PQ_LAZY_BINARY_HEAP) {
+            runDijkstraLazyHeap(startNode, state);
+        } else {
+            runDijkstraIndexedHeap(startNode, state);
         }
+        return true;
+    }
 
-        // 1. Initialize distances and visited status
-        GraphVertexNode* currentV = vertexListHead;
-        while (currentV) {
-            currentV->distFromSource = (currentV->id == startVertexID) ? 0 : 2147483647;
-            currentV->visited = false;
-            currentV = currentV->nextVertex;
+    void runDijkstraIndexedHeap(GraphVertexNode* startNode, GraphSearchState& state) {
+        IndexedDaryHeap pq(numVertices, 4);
+        pq.push(startNode->index, 0);
+
+        while (!pq.isEmpty()) {
+            GraphVertexNode* u = vertexByIndex[pq.pop()];
+            state.visited[u->index] = true;
+
+            GraphEdgeNode* edge = u->adjListHead;
+            while (edge) {
+                GraphVertexNode* v = findVertex(edge->toVertexID);
+                if (v && !state.visited[v->index]) {
+                    int newDist = state.dist[u->index] + edge->weight;
+                    if (newDist < state.dist[v->index]) {
+                        state.dist[v->index] = newDist;
+                        pq.pushOrDecrease(v->index, newDist);
+                    }
+                }
+                edge = edge->next;
+            }
+        }
+    }
+
+    void runDijkstraLazyHeap(GraphVertexNode* startNode, GraphSearchState& state) {
+        LazyBinaryHeap pq(numVertices);
+        pq.push(startNode->index, 0);
+
+        while (!pq.isEmpty()) {
+            HeapEntry top = pq.pop();
+            GraphVertexNode* u = vertexByIndex[top.key];
+            if (state.visited[u->index] || top.priority > state.dist[u->index]) continue; // Stale entry
+            state.visited[u->index] = true;
+
+            GraphEdgeNode* edge = u->adjListHead;
+            while (edge) {
+                GraphVertexNode* v = findVertex(edge->toVertexID);
+                if (v && !state.visited[v->index]) {
+                    int newDist = state.dist[u->index] + edge->weight;
+                    if (newDist < state.dist[v->index]) {
+                        state.dist[v->index] = newDist;
+                        pq.push(v->index, newDist);
+                    }
+                }
+                edge = edge->next;
+            }
         }
+    }
 
-        // 2. "Priority Queue" - Implemented as a sorted linked list of DijkstraNode
+    // Original implementation, kept as the baseline for RoutingBenchmark
+    void runDijkstraSortedList(GraphVertexNode* startNode, GraphSearchState& state) {
+        // "Priority Queue" - Implemented as a sorted linked list of DijkstraNode
         DijkstraNode* pqHead = NULL; // Head of our sorted linked list PQ
         ManualLinkedList dijkstraPQHelper; // Just to use its sortedInsertDijkstra method
 
-        dijkstraPQHelper.sortedInsertDijkstra(&pqHead, new DijkstraNode(startVertexID, 0));
-
-        cout << "Dijkstra's Shortest Paths from Vertex " << startVertexID << ":" << endl;
+        dijkstraPQHelper.sortedInsertDijkstra(&pqHead, new DijkstraNode(startNode->id, 0));
 
         while (pqHead != NULL) {
             // Extract min from our "PQ"
@@ -739,26 +1744,20 @@ public:
 
             GraphVertexNode* u = findVertex(minNode->vertexID);
 
-            if (!u || u->visited) { // Already processed or invalid
+            if (!u || state.visited[u->index]) { // Already processed or invalid
                 delete minNode;
                 continue;
             }
-            u->visited = true;
-
-            // For outputting path info (optional, complex to reconstruct full path without parent pointers)
-            // cout << "  Processing vertex " << u->id << " (current shortest_dist: " << u->distFromSource << ")" << endl;
-
+            state.visited[u->index] = true;
 
             // Iterate over neighbors
             GraphEdgeNode* edge = u->adjListHead;
             while (edge) {
                 GraphVertexNode* v = findVertex(edge->toVertexID);
-                if (v && !v->visited) {
-                    int newDist = u->distFromSource + edge->weight;
-                    if (newDist < v->distFromSource) {
-                        v->distFromSource = newDist;
-                        // Add/Update v in PQ
-                        // For sorted list, this means removing old if exists and inserting new.
+                if (v && !state.visited[v->index]) {
+                    int newDist = state.dist[u->index] + edge->weight;
+                    if (newDist < state.dist[v->index]) {
+                        state.dist[v->index] = newDist;
                         // Simpler: just insert. Duplicates will be handled by visited flag or later extraction.
                         dijkstraPQHelper.sortedInsertDijkstra(&pqHead, new DijkstraNode(v->id, newDist));
                     }
@@ -767,16 +1766,26 @@ public:
             }
             delete minNode; // Clean up the dequeued node from PQ
         }
+    }
+
+    void Dijkstra(int startVertexID) {
+        GraphSearchState state;
+        if (!computeDijkstra(startVertexID, state)) {
+            cout << "Dijkstra Error: Start vertex " << startVertexID << " not found." << endl;
+            return;
+        }
+
+        cout << "Dijkstra's Shortest Paths from Vertex " << startVertexID << ":" << endl;
 
         // Print results
         cout << "Vertex distances from " << startVertexID << ":" << endl;
-        currentV = vertexListHead;
+        GraphVertexNode* currentV = vertexListHead;
         while (currentV) {
             cout << "  To " << currentV->id << " (" << currentV->name << "): ";
-            if (currentV->distFromSource == 2147483647) {
+            if (state.dist[currentV->index] == INFINITY_DIST) {
                 cout << "Not Reachable" << endl;
             } else {
-                cout << currentV->distFromSource << endl;
+                cout << state.dist[currentV->index] << endl;
             }
             currentV = currentV->nextVertex;
         }
@@ -784,183 +1793,6750 @@ public:
 };
 
 
-// --- Smart City Entity Definitions ---
-struct Citizen {
-    int id;
-    string name;
-    string address;
-    // Other relevant data, e.g., utility IDs, can be linked via ManualLinkedList if needed
-    Citizen(int i=0, string n="", string addr=""): id(i), name(n), address(addr){}
+// --- Reusable scratch space for point-to-point searches on a CSRGraph ---
+// dist/parent entries are only valid when their stamp equals currentStamp, so starting a new
+// search is O(1) instead of an O(V) reset loop. One workspace serves one search at a time.
+class SearchWorkspace {
+public:
+    int capacity;
+    int* dist;
+    int* parent;          // Dense index of the predecessor, -1 for the source
+    unsigned int* stamp;
+    unsigned int currentStamp;
+    IndexedDaryHeap heap;
+    int settledCount;     // Vertices popped from the heap in the current search
+
+    SearchWorkspace(int n) : capacity(n), currentStamp(0), heap(n, 4), settledCount(0) {
+        dist = new int[n > 0 ? n : 1];
+        parent = new int[n > 0 ? n : 1];
+        stamp = new unsigned int[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) stamp[i] = 0;
+    }
+
+    ~SearchWorkspace() {
+        delete[] dist;
+        delete[] parent;
+        delete[] stamp;
+    }
+
+    void beginSearch() {
+        currentStamp++;
+        if (currentStamp == 0) { // Wrapped around: stamps from 2^32 searches ago would look valid
+            for (int i = 0; i < capacity; ++i) stamp[i] = 0;
+            currentStamp = 1;
+        }
+        heap.clear();
+        settledCount = 0;
+    }
+
+    int getDist(int v) const {
+        return stamp[v] == currentStamp ? dist[v] : INFINITY_DIST;
+    }
+
+    int getParent(int v) const {
+        return stamp[v] == currentStamp ? parent[v] : -1;
+    }
+
+    void setDist(int v, int d, int p) {
+        stamp[v] = currentStamp;
+        dist[v] = d;
+        parent[v] = p;
+    }
 };
 
-struct VehicleEntity { // To differentiate from QueueNode for traffic
-    string licensePlate;
-    string type; // CAR, BUS, EMERGENCY_VEHICLE
-    string ownerCitizenName; // Link to citizen
+// Result of a point-to-point route query, returned by value
+struct RouteResult {
+    bool found;
+    int cost;
+    int settledCount; // Vertices settled by the search that produced this route
+    int pathLength;
+    int* pathIDs;     // External vertex IDs, source first
 
-    VehicleEntity(string lp = "", string t = "", string owner = "") : licensePlate(lp), type(t), ownerCitizenName(owner) {}
+    RouteResult() : found(false), cost(INFINITY_DIST), settledCount(0), pathLength(0), pathIDs(NULL) {}
+
+    RouteResult(const RouteResult& other) : pathIDs(NULL) {
+        copyFrom(other);
+    }
+
+    RouteResult& operator=(const RouteResult& other) {
+        if (this != &other) {
+            delete[] pathIDs;
+            pathIDs = NULL;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    ~RouteResult() {
+        delete[] pathIDs;
+    }
+
+    void allocatePath(int length) {
+        delete[] pathIDs;
+        pathLength = length;
+        pathIDs = length > 0 ? new int[length] : NULL;
+    }
+
+private:
+    void copyFrom(const RouteResult& other) {
+        found = other.found;
+        cost = other.cost;
+        settledCount = other.settledCount;
+        pathLength = other.pathLength;
+        if (other.pathIDs) {
+            pathIDs = new int[pathLength];
+            for (int i = 0; i < pathLength; ++i) pathIDs[i] = other.pathIDs[i];
+        }
+    }
 };
 
 
-// --- Smart City Module Implementations ---
-class CitizenManagement {
+// --- Dense many-to-many distance table, row = source, column = target ---
+struct DistanceMatrix {
+    int rows;
+    int cols;
+    int* values; // rows * cols, INFINITY_DIST where a target is unreachable
+
+    DistanceMatrix(int r = 0, int c = 0) : rows(r), cols(c), values(NULL) {
+        if (r * c > 0) {
+            values = new int[r * c];
+            for (int i = 0; i < r * c; ++i) values[i] = INFINITY_DIST;
+        }
+    }
+
+    DistanceMatrix(const DistanceMatrix& other) : rows(0), cols(0), values(NULL) {
+        copyFrom(other);
+    }
+
+    DistanceMatrix& operator=(const DistanceMatrix& other) {
+        if (this != &other) {
+            delete[] values;
+            values = NULL;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    ~DistanceMatrix() {
+        delete[] values;
+    }
+
+    int get(int row, int col) const {
+        return values[row * cols + col];
+    }
+
+    void set(int row, int col, int value) {
+        values[row * cols + col] = value;
+    }
+
+private:
+    void copyFrom(const DistanceMatrix& other) {
+        rows = other.rows;
+        cols = other.cols;
+        if (other.values) {
+            values = new int[rows * cols];
+            for (int i = 0; i < rows * cols; ++i) values[i] = other.values[i];
+        }
+    }
+};
+
+// --- Isochrone results: one compact vertex set per source, stored back to back ---
+// Set i is vertexIDs/costs[setOffsets[i] .. setOffsets[i + 1]), ordered by increasing cost.
+struct IsochroneSet {
+    IntList setOffsets;
+    IntList vertexIDs;
+    IntList costs;
+
+    IsochroneSet() {
+        setOffsets.push(0);
+    }
+
+    void clear() {
+        setOffsets.clear();
+        setOffsets.push(0);
+        vertexIDs.clear();
+        costs.clear();
+    }
+
+    int numSets() const {
+        return setOffsets.size - 1;
+    }
+
+    int setSize(int set) const {
+        return setOffsets.data[set + 1] - setOffsets.data[set];
+    }
+
+private:
+    IsochroneSet(const IsochroneSet&);            // IntList members own raw arrays
+    IsochroneSet& operator=(const IsochroneSet&);
+};
+
+
+// --- Binary road network file: header followed by 8-byte aligned sections (host byte order) ---
+// coordX, coordY (double), vertexIDs, nameOffsets, edgeOffsets, edgeTargets, edgeWeights,
+// edgeProfiles, inOffsets, inSources, inWeights, profileStart, pointMinutes, pointValues (int),
+// namePool (char). The layout is exactly CSRGraph's arrays, so a loaded file is used in place.
+struct RoadNetworkFileHeader {
+    char magic[4];         // "RNET"
+    int formatVersion;     // ROAD_NETWORK_FORMAT_VERSION
+    int numVertices;
+    int numEdges;
+    int namePoolBytes;
+    int numProfiles;
+    int numProfilePoints;
+    int hasAllCoordinates;
+    double heuristicScale;
+    double timeDependentScale;
+};
+
+const int ROAD_NETWORK_FORMAT_VERSION = 1;
+
+// --- AMBITIOUS FEATURE: Compressed Sparse Row (CSR) snapshot of Graph ---
+// Frozen, read-only copy of a Graph: vertices get the dense index 0..N-1 used by the Graph,
+// and the out-edges of vertex i are edgeTargets/edgeWeights[edgeOffsets[i] .. edgeOffsets[i+1]).
+// Neighbor access is O(1) and a traversal walks contiguous memory instead of chasing
+// GraphEdgeNode pointers and calling findVertex for every edge.
+class CSRGraph {
 public:
-    ManualLinkedList citizenList; // Stores Citizen objects (conceptually, NodeLL will hold citizen data)
-    Trie citizenNameTrie; // For quick name search/autocomplete
+    int numVertices;
+    int numEdges;
+    int* vertexIDs;    // Dense index -> external vertex ID
+    int* nameOffsets;  // Name of vertex i is namePool[nameOffsets[i] .. nameOffsets[i+1]), see vertexName()
+    char* namePool;
+    int* edgeOffsets;  // Size numVertices + 1
+    int* edgeTargets;  // Dense index of the edge's head
+    int* edgeWeights;
+    int* inOffsets;    // Reverse CSR: incoming edges of vertex i are in[inOffsets[i] .. inOffsets[i+1])
+    int* inSources;    // Dense index of the edge's tail
+    int* inWeights;
+    VertexIndexMap idIndex;
+
+    // A* support: coordinates per dense index and the largest factor such that
+    // heuristicScale * straightLine(u, v) <= weight(u, v) holds for every edge
+    double* coordX;
+    double* coordY;
+    bool hasAllCoordinates;
+    double heuristicScale;
+
+    // Time-dependent routing: profile id per edge (-1 = constant weight). Every snapshot owns
+    // a copy of the pool (ownedProfiles), since the Graph's pool reallocates as the writer
+    // adds profiles while readers are still routing on older versions. timeDependentScale is
+    // heuristicScale computed from each profile's minimum.
+    int* edgeProfiles;
+    const TravelTimeProfilePool* profilePool;
+    double timeDependentScale;
+
+    // Snapshots opened with loadFromFile are views into one file buffer instead of owning
+    // each array (fileBuffer != NULL)
+    char* fileBuffer;
+    TravelTimeProfilePool* ownedProfiles;
+
+    CSRGraph(Graph& graph) : numVertices(graph.numVertices), numEdges(0), idIndex(graph.numVertices), hasAllCoordinates(true), heuristicScale(0),
+                             profilePool(NULL), timeDependentScale(0), fileBuffer(NULL), ownedProfiles(NULL) {
+        vertexIDs = new int[numVertices > 0 ? numVertices : 1];
+        nameOffsets = new int[numVertices + 1];
+        edgeOffsets = new int[numVertices + 1];
+        coordX = new double[numVertices > 0 ? numVertices : 1];
+        coordY = new double[numVertices > 0 ? numVertices : 1];
+
+        int nameBytes = 0;
+        for (int i = 0; i < numVertices; ++i) nameBytes += (int)graph.vertexByIndex[i]->name.size();
+        namePool = new char[nameBytes > 0 ? nameBytes : 1];
+        nameOffsets[0] = 0;
+
+        // Pass 1: count out-degrees into offsets
+        for (int i = 0; i < numVertices; ++i) {
+            GraphVertexNode* v = graph.vertexByIndex[i];
+            vertexIDs[i] = v->id;
+            const string& name = v->name;
+            for (int c = 0; c < (int)name.size(); ++c) namePool[nameOffsets[i] + c] = name[c];
+            nameOffsets[i + 1] = nameOffsets[i] + (int)name.size();
+            idIndex.insert(v->id, i);
+            coordX[i] = v->x;
+            coordY[i] = v->y;
+            if (!v->hasCoordinates) hasAllCoordinates = false;
+            edgeOffsets[i] = numEdges;
+            GraphEdgeNode* edge = v->adjListHead;
+            while (edge) {
+                numEdges++;
+                edge = edge->next;
+            }
+        }
+        edgeOffsets[numVertices] = numEdges;
+
+        // Pass 2: copy edges, keeping the adjacency list order
+        edgeTargets = new int[numEdges > 0 ? numEdges : 1];
+        edgeWeights = new int[numEdges > 0 ? numEdges : 1];
+        edgeProfiles = new int[numEdges > 0 ? numEdges : 1];
+        for (int i = 0; i < numVertices; ++i) {
+            int e = edgeOffsets[i];
+            GraphEdgeNode* edge = graph.vertexByIndex[i]->adjListHead;
+            while (edge) {
+                edgeTargets[e] = graph.findVertex(edge->toVertexID)->index;
+                edgeWeights[e] = edge->weight;
+                edgeProfiles[e] = edge->profileId;
+                e++;
+                edge = edge->next;
+            }
+        }
+
+        // Reverse CSR from the Graph's incoming-edge lists
+        inOffsets = new int[numVertices + 1];
+        inSources = new int[numEdges > 0 ? numEdges : 1];
+        inWeights = new int[numEdges > 0 ? numEdges : 1];
+        int e = 0;
+        for (int i = 0; i < numVertices; ++i) {
+            inOffsets[i] = e;
+            GraphEdgeNode* edge = graph.vertexByIndex[i]->inListHead;
+            while (edge) {
+                inSources[e] = graph.findVertex(edge->toVertexID)->index;
+                inWeights[e] = edge->weight;
+                e++;
+                edge = edge->next;
+            }
+        }
+        inOffsets[numVertices] = e;
+
+        // The pool holds no duplicates, so re-adding its profiles in order keeps their ids
+        ownedProfiles = new TravelTimeProfilePool();
+        profilePool = ownedProfiles;
+        const TravelTimeProfilePool& source = graph.profiles;
+        for (int p = 0; p < source.numProfiles; ++p) {
+            int first = source.profileStart.data[p];
+            ownedProfiles->addProfile(source.pointMinutes.data + first, source.pointValues.data + first, source.profileStart.data[p + 1] - first);
+        }
+
+        computeHeuristicScale();
+    }
+
+    // Empty snapshot, to be filled by loadFromFile
+    CSRGraph() : numVertices(0), numEdges(0), hasAllCoordinates(false), heuristicScale(0), profilePool(NULL), timeDependentScale(0),
+                 fileBuffer(NULL), ownedProfiles(NULL) {
+        vertexIDs = NULL;
+        nameOffsets = NULL;
+        namePool = NULL;
+        edgeOffsets = NULL;
+        edgeTargets = NULL;
+        edgeWeights = NULL;
+        edgeProfiles = NULL;
+        inOffsets = NULL;
+        inSources = NULL;
+        inWeights = NULL;
+        coordX = NULL;
+        coordY = NULL;
+        ownedProfiles = new TravelTimeProfilePool();
+        profilePool = ownedProfiles;
+    }
+
+    ~CSRGraph() {
+        release();
+    }
+
+    void release() {
+        if (fileBuffer) {
+            delete[] fileBuffer;
+            fileBuffer = NULL;
+        } else {
+            delete[] vertexIDs;
+            delete[] nameOffsets;
+            delete[] namePool;
+            delete[] edgeOffsets;
+            delete[] edgeTargets;
+            delete[] edgeWeights;
+            delete[] edgeProfiles;
+            delete[] inOffsets;
+            delete[] inSources;
+            delete[] inWeights;
+            delete[] coordX;
+            delete[] coordY;
+        }
+        vertexIDs = NULL;
+        nameOffsets = NULL;
+        namePool = NULL;
+        edgeOffsets = NULL;
+        edgeTargets = NULL;
+        edgeWeights = NULL;
+        edgeProfiles = NULL;
+        inOffsets = NULL;
+        inSources = NULL;
+        inWeights = NULL;
+        coordX = NULL;
+        coordY = NULL;
+        numVertices = 0;
+        numEdges = 0;
+        delete ownedProfiles;
+        ownedProfiles = NULL;
+        profilePool = NULL;
+        idIndex.clear();
+    }
+
+    string vertexName(int index) const {
+        return string(namePool + nameOffsets[index], nameOffsets[index + 1] - nameOffsets[index]);
+    }
+
+    // Without coordinates on every vertex there is no admissible bound and A* degrades to Dijkstra
+    void computeHeuristicScale() {
+        heuristicScale = 0;
+        timeDependentScale = 0;
+        if (!hasAllCoordinates) return;
+        bool first = true;
+        for (int u = 0; u < numVertices; ++u) {
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                double length = straightLine(u, edgeTargets[e]);
+                if (length <= 0) continue;
+                double ratio = edgeWeights[e] / length;
+                int fastest = edgeProfiles[e] == -1 ? edgeWeights[e] : profilePool->minTravelTime(edgeProfiles[e]);
+                double tdRatio = fastest / length;
+                if (first || ratio < heuristicScale) heuristicScale = ratio;
+                if (first || tdRatio < timeDependentScale) timeDependentScale = tdRatio;
+                first = false;
+            }
+        }
+        heuristicScale *= 0.999999; // Keep rounding error from making the bound inadmissible
+        timeDependentScale *= 0.999999;
+    }
+
+    // Travel time of edge e when entered at minute 'departure'
+    int edgeTravelTime(int e, int departure) const {
+        return edgeProfiles[e] == -1 ? edgeWeights[e] : profilePool->travelTime(edgeProfiles[e], departure);
+    }
+
+    double straightLine(int u, int v) const {
+        double dx = coordX[u] - coordX[v];
+        double dy = coordY[u] - coordY[v];
+        return manualSqrt(dx * dx + dy * dy);
+    }
+
+    // Lower bound on the remaining cost from v to target (consistent, so no vertex is re-opened)
+    int heuristic(int v, int target) const {
+        if (heuristicScale <= 0) return 0;
+        return (int)(heuristicScale * straightLine(v, target));
+    }
+
+    int indexOf(int vertexID) const { // -1 if the ID is not in the snapshot
+        return idIndex.find(vertexID);
+    }
+
+    // Cheap checksum of IDs, topology and weights, used to tell whether saved
+    // preprocessing (e.g. a ContractionHierarchy file) still matches this graph
+    unsigned int fingerprint() const {
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < numVertices; ++i) h = (h ^ (unsigned int)vertexIDs[i]) * 16777619u;
+        for (int i = 0; i <= numVertices; ++i) h = (h ^ (unsigned int)edgeOffsets[i]) * 16777619u;
+        for (int e = 0; e < numEdges; ++e) {
+            h = (h ^ (unsigned int)edgeTargets[e]) * 16777619u;
+            h = (h ^ (unsigned int)edgeWeights[e]) * 16777619u;
+        }
+        return h;
+    }
+
+    // --- Persistence: versioned binary road network file ---
+    bool saveToFile(const string& filename) const {
+        ofstream out(filename.c_str(), ios::binary);
+        if (!out) return false;
+        RoadNetworkFileHeader header;
+        header.magic[0] = 'R';
+        header.magic[1] = 'N';
+        header.magic[2] = 'E';
+        header.magic[3] = 'T';
+        header.formatVersion = ROAD_NETWORK_FORMAT_VERSION;
+        header.numVertices = numVertices;
+        header.numEdges = numEdges;
+        header.namePoolBytes = nameOffsets[numVertices];
+        header.numProfiles = profilePool->numProfiles;
+        header.numProfilePoints = profilePool->pointMinutes.size;
+        header.hasAllCoordinates = hasAllCoordinates ? 1 : 0;
+        header.heuristicScale = heuristicScale;
+        header.timeDependentScale = timeDependentScale;
+        out.write((const char*)&header, sizeof(header));
+        writeSection(out, coordX, sizeof(double) * numVertices);
+        writeSection(out, coordY, sizeof(double) * numVertices);
+        writeSection(out, vertexIDs, sizeof(int) * numVertices);
+        writeSection(out, nameOffsets, sizeof(int) * (numVertices + 1));
+        writeSection(out, edgeOffsets, sizeof(int) * (numVertices + 1));
+        writeSection(out, edgeTargets, sizeof(int) * numEdges);
+        writeSection(out, edgeWeights, sizeof(int) * numEdges);
+        writeSection(out, edgeProfiles, sizeof(int) * numEdges);
+        writeSection(out, inOffsets, sizeof(int) * (numVertices + 1));
+        writeSection(out, inSources, sizeof(int) * numEdges);
+        writeSection(out, inWeights, sizeof(int) * numEdges);
+        writeSection(out, profilePool->profileStart.data, sizeof(int) * (header.numProfiles + 1));
+        writeSection(out, profilePool->pointMinutes.data, sizeof(int) * header.numProfilePoints);
+        writeSection(out, profilePool->pointValues.data, sizeof(int) * header.numProfilePoints);
+        writeSection(out, namePool, header.namePoolBytes);
+        return (bool)out;
+    }
+
+    // One read of the whole file into a single buffer; the arrays then point into it, so the
+    // only per-element work left is rebuilding the ID hash index and validating the topology.
+    bool loadFromFile(const string& filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in) return false;
+        in.seekg(0, ios::end);
+        long long fileSize = (long long)in.tellg();
+        in.seekg(0, ios::beg);
+        if (fileSize < (long long)sizeof(RoadNetworkFileHeader)) return false;
+        RoadNetworkFileHeader header;
+        in.read((char*)&header, sizeof(header));
+        if (!in || header.magic[0] != 'R' || header.magic[1] != 'N' || header.magic[2] != 'E' || header.magic[3] != 'T' ||
+            header.formatVersion != ROAD_NETWORK_FORMAT_VERSION || header.numVertices < 0 || header.numEdges < 0 ||
+            header.namePoolBytes < 0 || header.numProfiles < 0 || header.numProfilePoints < 0) {
+            return false;
+        }
+        long long n = header.numVertices, m = header.numEdges;
+        long long expected = sizeof(header) + 2 * padded(sizeof(double) * n) + padded(sizeof(int) * n) + 3 * padded(sizeof(int) * (n + 1)) +
+                             5 * padded(sizeof(int) * m) + padded(sizeof(int) * (header.numProfiles + 1)) +
+                             2 * padded(sizeof(int) * header.numProfilePoints) + padded(header.namePoolBytes);
+        if (expected != fileSize) return false;
+
+        char* buffer = new char[fileSize];
+        in.seekg(0, ios::beg);
+        in.read(buffer, fileSize);
+        if (!in) {
+            delete[] buffer;
+            return false;
+        }
+
+        release();
+        fileBuffer = buffer;
+        long long cursor = sizeof(header);
+        coordX = (double*)takeSection(cursor, sizeof(double) * n);
+        coordY = (double*)takeSection(cursor, sizeof(double) * n);
+        vertexIDs = (int*)takeSection(cursor, sizeof(int) * n);
+        nameOffsets = (int*)takeSection(cursor, sizeof(int) * (n + 1));
+        edgeOffsets = (int*)takeSection(cursor, sizeof(int) * (n + 1));
+        edgeTargets = (int*)takeSection(cursor, sizeof(int) * m);
+        edgeWeights = (int*)takeSection(cursor, sizeof(int) * m);
+        edgeProfiles = (int*)takeSection(cursor, sizeof(int) * m);
+        inOffsets = (int*)takeSection(cursor, sizeof(int) * (n + 1));
+        inSources = (int*)takeSection(cursor, sizeof(int) * m);
+        inWeights = (int*)takeSection(cursor, sizeof(int) * m);
+        const int* profileStart = (const int*)takeSection(cursor, sizeof(int) * (header.numProfiles + 1));
+        const int* pointMinutes = (const int*)takeSection(cursor, sizeof(int) * header.numProfilePoints);
+        const int* pointValues = (const int*)takeSection(cursor, sizeof(int) * header.numProfilePoints);
+        namePool = takeSection(cursor, header.namePoolBytes);
+        numVertices = header.numVertices;
+        numEdges = header.numEdges;
+
+        // Profiles are small and rebuilt through addProfile, which also re-checks them
+        ownedProfiles = new TravelTimeProfilePool();
+        profilePool = ownedProfiles;
+        bool valid = profileStart[0] == 0 && profileStart[header.numProfiles] == header.numProfilePoints;
+        for (int p = 0; valid && p < header.numProfiles; ++p) {
+            int count = profileStart[p + 1] - profileStart[p];
+            if (count <= 0 || profileStart[p + 1] > header.numProfilePoints ||
+                ownedProfiles->addProfile(pointMinutes + profileStart[p], pointValues + profileStart[p], count) != p) {
+                valid = false;
+            }
+        }
+        if (valid) valid = validOffsets(edgeOffsets, edgeTargets, inOffsets, inSources) && nameOffsets[0] == 0 && nameOffsets[numVertices] == header.namePoolBytes;
+        for (int i = 0; valid && i < numVertices; ++i) {
+            if (nameOffsets[i + 1] < nameOffsets[i]) valid = false;
+        }
+        for (int e = 0; valid && e < numEdges; ++e) {
+            if (edgeProfiles[e] < -1 || edgeProfiles[e] >= header.numProfiles || edgeWeights[e] < 0 || inWeights[e] < 0) valid = false;
+        }
+        if (valid) valid = reverseMatchesForward();
+        idIndex.reserve(numVertices);
+        for (int i = 0; valid && i < numVertices; ++i) {
+            if (idIndex.find(vertexIDs[i]) != -1) valid = false; // Duplicate ID, as Graph::addVertex refuses
+            else idIndex.insert(vertexIDs[i], i);
+        }
+        if (!valid) {
+            release();
+            return false;
+        }
+
+        // The A* scales are recomputed rather than trusted: a scale from a stale or damaged
+        // header could overestimate. The header can only turn coordinates off; the bound itself
+        // is derived from the stored coordinates, so it is admissible whatever they are.
+        hasAllCoordinates = header.hasAllCoordinates != 0;
+        for (int i = 0; hasAllCoordinates && i < numVertices; ++i) {
+            if (coordX[i] - coordX[i] != 0 || coordY[i] - coordY[i] != 0) hasAllCoordinates = false; // NaN or infinite
+        }
+        computeHeuristicScale();
+        return true;
+    }
+
+    int outDegree(int index) const {
+        return edgeOffsets[index + 1] - edgeOffsets[index];
+    }
+
+    // Fills dist[0..N-1] (2147483647 = unreachable) from the given dense source index.
+    // With reverse = true it follows incoming edges, giving distances *to* the source instead.
+    void computeDistances(int sourceIndex, int* dist, bool reverse = false) const {
+        for (int i = 0; i < numVertices; ++i) dist[i] = 2147483647;
+        IndexedDaryHeap pq(numVertices, 4);
+        dist[sourceIndex] = 0;
+        pq.push(sourceIndex, 0);
+        const int* offsets = reverse ? inOffsets : edgeOffsets;
+        const int* heads = reverse ? inSources : edgeTargets;
+        const int* weights = reverse ? inWeights : edgeWeights;
+
+        while (!pq.isEmpty()) {
+            int u = pq.pop();
+            int du = dist[u];
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = heads[e];
+                int newDist = du + weights[e];
+                if (newDist < dist[v]) {
+                    dist[v] = newDist;
+                    pq.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+    }
+
+    // --- AMBITIOUS FEATURE: Point-to-point shortest path with early termination ---
+    // Stops as soon as the target is settled and rebuilds the route from parent pointers.
+    RouteResult shortestPath(int sourceID, int targetID, SearchWorkspace& ws) const {
+        RouteResult result;
+        int source = indexOf(sourceID);
+        int target = indexOf(targetID);
+        if (source == -1 || target == -1) return result;
+
+        ws.beginSearch();
+        ws.setDist(source, 0, -1);
+        ws.heap.push(source, 0);
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == target) break;
+            int du = ws.getDist(u);
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                int v = edgeTargets[e];
+                int newDist = du + edgeWeights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+        result.settledCount = ws.settledCount;
+        buildRoute(ws, target, result);
+        return result;
+    }
+
+    RouteResult shortestPath(int sourceID, int targetID) const {
+        SearchWorkspace ws(numVertices);
+        return shortestPath(sourceID, targetID, ws);
+    }
+
+    // --- AMBITIOUS FEATURE: A* search with a straight-line heuristic ---
+    // Heap priority is dist + heuristic; ws.dist still holds the exact distance from the source.
+    RouteResult aStarPath(int sourceID, int targetID, SearchWorkspace& ws) const {
+        RouteResult result;
+        int source = indexOf(sourceID);
+        int target = indexOf(targetID);
+        if (source == -1 || target == -1) return result;
+
+        ws.beginSearch();
+        ws.setDist(source, 0, -1);
+        ws.heap.push(source, heuristic(source, target));
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == target) break;
+            int du = ws.getDist(u);
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                int v = edgeTargets[e];
+                int newDist = du + edgeWeights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist + heuristic(v, target));
+                }
+            }
+        }
+        result.settledCount = ws.settledCount;
+        buildRoute(ws, target, result);
+        return result;
+    }
+
+    // --- AMBITIOUS FEATURE: Time-dependent Dijkstra / A* ---
+    // Labels are arrival minutes instead of distances; an edge is priced at the moment it is
+    // entered. With FIFO profiles arriving earlier never hurts, so the usual label-setting
+    // argument holds and every vertex is settled once. useAStar adds the straight-line bound
+    // scaled by the fastest travel time any road can have (timeDependentScale).
+    // result.cost is the travel time, i.e. arrival - departure.
+    RouteResult timeDependentPath(int sourceID, int targetID, int departure, SearchWorkspace& ws, bool useAStar = false) const {
+        RouteResult result;
+        int source = indexOf(sourceID);
+        int target = indexOf(targetID);
+        if (source == -1 || target == -1) return result;
+        double scale = useAStar ? timeDependentScale : 0;
+
+        ws.beginSearch();
+        ws.setDist(source, departure, -1);
+        ws.heap.push(source, departure + (int)(scale * straightLine(source, target)));
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == target) break;
+            int arrival = ws.getDist(u);
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                int v = edgeTargets[e];
+                int newArrival = arrival + edgeTravelTime(e, arrival);
+                if (newArrival < ws.getDist(v)) {
+                    ws.setDist(v, newArrival, u);
+                    ws.heap.pushOrDecrease(v, newArrival + (int)(scale * straightLine(v, target)));
+                }
+            }
+        }
+        result.settledCount = ws.settledCount;
+        buildRoute(ws, target, result);
+        if (result.found) result.cost -= departure;
+        return result;
+    }
+
+    // --- AMBITIOUS FEATURE: Bidirectional Dijkstra ---
+    // forward searches out-edges from the source, backward searches in-edges from the target.
+    // Each step expands the side with the smaller tentative key; once topForward + topBackward
+    // is no better than the best meeting cost found so far, no shorter path can exist.
+    RouteResult bidirectionalPath(int sourceID, int targetID, SearchWorkspace& forward, SearchWorkspace& backward) const {
+        RouteResult result;
+        int source = indexOf(sourceID);
+        int target = indexOf(targetID);
+        if (source == -1 || target == -1) return result;
+
+        forward.beginSearch();
+        backward.beginSearch();
+        forward.setDist(source, 0, -1);
+        forward.heap.push(source, 0);
+        backward.setDist(target, 0, -1);
+        backward.heap.push(target, 0);
+        int best = INFINITY_DIST;
+        int meet = -1;
+        if (source == target) {
+            best = 0;
+            meet = source;
+        }
+
+        while (!forward.heap.isEmpty() || !backward.heap.isEmpty()) {
+            int topF = forward.heap.isEmpty() ? INFINITY_DIST : forward.heap.topPriority();
+            int topB = backward.heap.isEmpty() ? INFINITY_DIST : backward.heap.topPriority();
+            if (best != INFINITY_DIST && (long long)topF + topB >= best) break;
+
+            bool expandForward = topF <= topB;
+            SearchWorkspace& ws = expandForward ? forward : backward;
+            SearchWorkspace& other = expandForward ? backward : forward;
+            const int* offsets = expandForward ? edgeOffsets : inOffsets;
+            const int* heads = expandForward ? edgeTargets : inSources;
+            const int* weights = expandForward ? edgeWeights : inWeights;
+
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            int du = ws.getDist(u);
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = heads[e];
+                int newDist = du + weights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+                int otherDist = other.getDist(v);
+                if (otherDist != INFINITY_DIST && ws.getDist(v) + otherDist < best) {
+                    best = ws.getDist(v) + otherDist;
+                    meet = v;
+                }
+            }
+        }
+
+        result.settledCount = forward.settledCount + backward.settledCount;
+        if (meet == -1) return result;
+
+        // source .. meet from forward parents, then meet .. target from backward parents
+        int length = 0;
+        for (int v = meet; v != -1; v = forward.getParent(v)) length++;
+        for (int v = backward.getParent(meet); v != -1; v = backward.getParent(v)) length++;
+        result.allocatePath(length);
+        int pos = 0;
+        for (int v = meet; v != -1; v = forward.getParent(v)) pos++;
+        int fill = pos - 1;
+        for (int v = meet; v != -1; v = forward.getParent(v)) result.pathIDs[fill--] = vertexIDs[v];
+        for (int v = backward.getParent(meet); v != -1; v = backward.getParent(v)) result.pathIDs[pos++] = vertexIDs[v];
+        result.found = true;
+        result.cost = best;
+        return result;
+    }
+
+    // Many-to-many by one Dijkstra per source that stops once every target is settled.
+    // The workspace is reused across sources, so no per-source O(V) reset is paid.
+    DistanceMatrix distanceMatrix(const int* sourceIDs, int numSources, const int* targetIDs, int numTargets, SearchWorkspace& ws) const {
+        DistanceMatrix matrix(numSources, numTargets);
+        // firstColumn[v] / nextColumn[j] chain the matrix columns of vertex v (IDs may repeat)
+        int* firstColumn = new int[numVertices > 0 ? numVertices : 1];
+        int* nextColumn = new int[numTargets > 0 ? numTargets : 1];
+        for (int v = 0; v < numVertices; ++v) firstColumn[v] = -1;
+        int validTargets = 0;
+        for (int j = 0; j < numTargets; ++j) {
+            int t = indexOf(targetIDs[j]);
+            nextColumn[j] = -1;
+            if (t == -1) continue;
+            nextColumn[j] = firstColumn[t];
+            firstColumn[t] = j;
+            validTargets++;
+        }
+
+        for (int i = 0; i < numSources; ++i) {
+            int source = indexOf(sourceIDs[i]);
+            if (source == -1) continue;
+            ws.beginSearch();
+            ws.setDist(source, 0, -1);
+            ws.heap.push(source, 0);
+            int remaining = validTargets; // Once every target is settled the search can stop
+            while (!ws.heap.isEmpty() && remaining > 0) {
+                int u = ws.heap.pop();
+                int du = ws.getDist(u);
+                for (int j = firstColumn[u]; j != -1; j = nextColumn[j]) {
+                    matrix.set(i, j, du);
+                    remaining--;
+                }
+                for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                    int v = edgeTargets[e];
+                    int newDist = du + edgeWeights[e];
+                    if (newDist < ws.getDist(v)) {
+                        ws.setDist(v, newDist, u);
+                        ws.heap.pushOrDecrease(v, newDist);
+                    }
+                }
+            }
+        }
+        delete[] firstColumn;
+        delete[] nextColumn;
+        return matrix;
+    }
+
+    // --- AMBITIOUS FEATURE: Isochrones (everything reachable within a cost budget) ---
+    // Dijkstra that never queues a vertex beyond the budget. The workspace stamps make the
+    // per-source reset O(1), so a batch over thousands of stations only pays for the vertices
+    // each isochrone contains. Appends one set to 'out' (empty for an unknown source) and
+    // returns its size.
+    int isochrone(int sourceID, int budget, SearchWorkspace& ws, IsochroneSet& out) const {
+        int source = indexOf(sourceID);
+        int count = 0;
+        if (source != -1 && budget >= 0) {
+            ws.beginSearch();
+            ws.setDist(source, 0, -1);
+            ws.heap.push(source, 0);
+            while (!ws.heap.isEmpty()) {
+                int u = ws.heap.pop();
+                int du = ws.getDist(u);
+                out.vertexIDs.push(vertexIDs[u]);
+                out.costs.push(du);
+                count++;
+                for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                    int v = edgeTargets[e];
+                    int newDist = du + edgeWeights[e];
+                    if (newDist <= budget && newDist < ws.getDist(v)) {
+                        ws.setDist(v, newDist, u);
+                        ws.heap.pushOrDecrease(v, newDist);
+                    }
+                }
+            }
+        }
+        out.setOffsets.push(out.vertexIDs.size);
+        return count;
+    }
+
+    // One isochrone per station, all with the same budget, sharing one workspace
+    void isochrones(const int* sourceIDs, int numSources, int budget, SearchWorkspace& ws, IsochroneSet& out) const {
+        out.clear();
+        for (int i = 0; i < numSources; ++i) isochrone(sourceIDs[i], budget, ws, out);
+    }
+
+    // The same batch on 'threads' workers: each takes a contiguous run of stations with its own
+    // workspace and result buffer, and the buffers are appended in worker order, so 'out' is
+    // identical to the single-workspace version
+    void isochrones(const int* sourceIDs, int numSources, int budget, IsochroneSet& out, int threads) const {
+        IsochroneBatch batch(*this, sourceIDs, numSources, budget, threads);
+        runWorkers(batch.numWorkers, isochroneWorker, &batch);
+        out.clear();
+        for (int t = 0; t < batch.numWorkers; ++t) {
+            const IsochroneSet& part = batch.parts[t];
+            int base = out.vertexIDs.size;
+            for (int k = 0; k < part.vertexIDs.size; ++k) {
+                out.vertexIDs.push(part.vertexIDs.data[k]);
+                out.costs.push(part.costs.data[k]);
+            }
+            for (int i = 1; i < part.setOffsets.size; ++i) out.setOffsets.push(base + part.setOffsets.data[i]);
+        }
+    }
+
+    struct IsochroneBatch {
+        const CSRGraph& graph;
+        const int* sourceIDs;
+        int numSources;
+        int budget;
+        int numWorkers;
+        IsochroneSet* parts; // Per worker
+
+        IsochroneBatch(const CSRGraph& g, const int* sources, int count, int limit, int threads)
+            : graph(g), sourceIDs(sources), numSources(count), budget(limit), numWorkers(threads < 1 ? 1 : threads) {
+            if (numWorkers > numSources && numSources > 0) numWorkers = numSources;
+            parts = new IsochroneSet[numWorkers];
+        }
+
+        ~IsochroneBatch() {
+            delete[] parts;
+        }
+
+    private:
+        IsochroneBatch(const IsochroneBatch&);
+        IsochroneBatch& operator=(const IsochroneBatch&);
+    };
+
+    static void isochroneWorker(void* context, int worker) {
+        IsochroneBatch& batch = *(IsochroneBatch*)context;
+        SearchWorkspace ws(batch.graph.numVertices); // Reused by every station of this worker
+        int first = (int)((long long)batch.numSources * worker / batch.numWorkers);
+        int end = (int)((long long)batch.numSources * (worker + 1) / batch.numWorkers);
+        for (int i = first; i < end; ++i) batch.graph.isochrone(batch.sourceIDs[i], batch.budget, ws, batch.parts[worker]);
+    }
+
+    // Fills result.cost and result.pathIDs by walking ws.parent back from target
+    void buildRoute(const SearchWorkspace& ws, int target, RouteResult& result) const {
+        int cost = ws.getDist(target);
+        if (cost == INFINITY_DIST) return;
+        int length = 0;
+        for (int v = target; v != -1; v = ws.getParent(v)) length++;
+        result.allocatePath(length);
+        int pos = length - 1;
+        for (int v = target; v != -1; v = ws.getParent(v)) result.pathIDs[pos--] = vertexIDs[v];
+        result.found = true;
+        result.cost = cost;
+    }
+
+    void BFS(int startVertexID) const {
+        int start = indexOf(startVertexID);
+        if (start == -1) {
+            cout << "BFS Error: Start vertex " << startVertexID << " not found." << endl;
+            return;
+        }
+        // The queue is a plain array: every vertex is enqueued at most once
+        int* queue = new int[numVertices];
+        bool* visited = new bool[numVertices];
+        for (int i = 0; i < numVertices; ++i) visited[i] = false;
+        int head = 0, tail = 0;
+
+        cout << "BFS starting from vertex " << startVertexID << ": ";
+        visited[start] = true;
+        queue[tail++] = start;
+        while (head < tail) {
+            int u = queue[head++];
+            cout << vertexIDs[u] << " ";
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                int v = edgeTargets[e];
+                if (!visited[v]) {
+                    visited[v] = true;
+                    queue[tail++] = v;
+                }
+            }
+        }
+        cout << endl;
+        delete[] queue;
+        delete[] visited;
+    }
+
+    // Preorder of an iterative DFS from start into order[]; returns the number of vertices
+    // visited. stackEdge[k] is the next out-edge to try for the k-th vertex on the path, so
+    // the visit order matches the recursive formulation without using the call stack.
+    int depthFirstOrder(int start, int* order) const {
+        bool* visited = new bool[numVertices > 0 ? numVertices : 1];
+        int* stackVertex = new int[numVertices > 0 ? numVertices : 1];
+        int* stackEdge = new int[numVertices > 0 ? numVertices : 1];
+        for (int i = 0; i < numVertices; ++i) visited[i] = false;
+        int count = 0, top = 0;
+        visited[start] = true;
+        order[count++] = start;
+        stackVertex[top] = start;
+        stackEdge[top++] = edgeOffsets[start];
+        while (top > 0) {
+            int u = stackVertex[top - 1];
+            if (stackEdge[top - 1] == edgeOffsets[u + 1]) {
+                top--;
+                continue;
+            }
+            int v = edgeTargets[stackEdge[top - 1]++];
+            if (!visited[v]) {
+                visited[v] = true;
+                order[count++] = v;
+                stackVertex[top] = v;
+                stackEdge[top++] = edgeOffsets[v];
+            }
+        }
+        delete[] visited;
+        delete[] stackVertex;
+        delete[] stackEdge;
+        return count;
+    }
+
+    void DFS(int startVertexID) const {
+        int start = indexOf(startVertexID);
+        if (start == -1) {
+            cout << "DFS Error: Start vertex " << startVertexID << " not found." << endl;
+            return;
+        }
+        int* order = new int[numVertices];
+        int count = depthFirstOrder(start, order);
+        cout << "DFS starting from vertex " << startVertexID << ": ";
+        for (int i = 0; i < count; ++i) cout << vertexIDs[order[i]] << " ";
+        cout << endl;
+        delete[] order;
+    }
+
+    // --- AMBITIOUS FEATURE: Strongly connected components (iterative Tarjan) ---
+    // component[v] receives a label 0..count-1; labels come out in reverse topological order
+    // of the condensation. Same explicit (vertex, edge cursor) stack as depthFirstOrder.
+    int stronglyConnectedComponents(int* component) const {
+        int size = numVertices > 0 ? numVertices : 1;
+        int* discovery = new int[size];
+        int* low = new int[size];
+        bool* onStack = new bool[size];
+        int* sccStack = new int[size];
+        int* callVertex = new int[size];
+        int* callEdge = new int[size];
+        for (int i = 0; i < numVertices; ++i) {
+            discovery[i] = -1;
+            onStack[i] = false;
+        }
+        int counter = 0, components = 0, sccTop = 0;
+
+        for (int root = 0; root < numVertices; ++root) {
+            if (discovery[root] != -1) continue;
+            int callTop = 0;
+            discovery[root] = low[root] = counter++;
+            sccStack[sccTop++] = root;
+            onStack[root] = true;
+            callVertex[callTop] = root;
+            callEdge[callTop++] = edgeOffsets[root];
+            while (callTop > 0) {
+                int u = callVertex[callTop - 1];
+                if (callEdge[callTop - 1] < edgeOffsets[u + 1]) {
+                    int v = edgeTargets[callEdge[callTop - 1]++];
+                    if (discovery[v] == -1) {
+                        discovery[v] = low[v] = counter++;
+                        sccStack[sccTop++] = v;
+                        onStack[v] = true;
+                        callVertex[callTop] = v;
+                        callEdge[callTop++] = edgeOffsets[v];
+                    } else if (onStack[v] && discovery[v] < low[u]) {
+                        low[u] = discovery[v];
+                    }
+                    continue;
+                }
+                // u is finished: close its component if it is the root, then report to the caller
+                callTop--;
+                if (low[u] == discovery[u]) {
+                    int w;
+                    do {
+                        w = sccStack[--sccTop];
+                        onStack[w] = false;
+                        component[w] = components;
+                    } while (w != u);
+                    components++;
+                }
+                if (callTop > 0 && low[u] < low[callVertex[callTop - 1]]) low[callVertex[callTop - 1]] = low[u];
+            }
+        }
+        delete[] discovery;
+        delete[] low;
+        delete[] onStack;
+        delete[] sccStack;
+        delete[] callVertex;
+        delete[] callEdge;
+        return components;
+    }
+
+    // --- Weakly connected components (union-find) ---
+    // Road direction ignored: each edge unites its endpoints (union by size, path halving).
+    // Labels 0..count-1 are assigned in order of the lowest dense index in each component.
+    // With several workers the vertices are split into contiguous index ranges: each worker
+    // unites the edges inside its own range, which only touches that range's parent entries,
+    // and sets aside the edges leaving it; those are united on the calling thread afterwards
+    // (grids and imported networks are numbered row by row, so there are few of them). The
+    // final root lookups do not compress paths and run on the workers as well.
+    int weaklyConnectedComponents(int* component, int threads = 1) const {
+        ComponentsWork work(*this, threads, component);
+        runWorkers(work.numWorkers, uniteWithinRange, &work);
+        for (int t = 0; t < work.numWorkers; ++t) {
+            for (int i = 0; i < work.crossTails[t].size; ++i) {
+                unite(work.parent, work.setSize, work.crossTails[t].data[i], work.crossHeads[t].data[i]);
+            }
+        }
+        runWorkers(work.numWorkers, rootsInRange, &work);
+        // Reuse setSize as root -> label
+        for (int i = 0; i < numVertices; ++i) work.setSize[i] = -1;
+        int components = 0;
+        for (int v = 0; v < numVertices; ++v) {
+            int root = component[v];
+            if (work.setSize[root] == -1) work.setSize[root] = components++;
+            component[v] = work.setSize[root];
+        }
+        return components;
+    }
+
+    static int findRoot(int* parent, int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    static void unite(int* parent, int* setSize, int u, int v) {
+        int a = findRoot(parent, u);
+        int b = findRoot(parent, v);
+        if (a == b) return;
+        if (setSize[a] < setSize[b]) {
+            int swap = a;
+            a = b;
+            b = swap;
+        }
+        parent[b] = a;
+        setSize[a] += setSize[b];
+    }
+
+    // Shared state of one weaklyConnectedComponents call; worker t owns vertices [first(t), first(t + 1))
+    struct ComponentsWork {
+        const CSRGraph& graph;
+        int numWorkers;
+        int* component;
+        int* parent;
+        int* setSize;
+        IntList* crossTails; // Per worker: edges leaving its range, united afterwards
+        IntList* crossHeads;
+
+        ComponentsWork(const CSRGraph& g, int threads, int* out) : graph(g), numWorkers(threads < 1 ? 1 : threads), component(out) {
+            if (numWorkers > g.numVertices && g.numVertices > 0) numWorkers = g.numVertices;
+            parent = new int[g.numVertices > 0 ? g.numVertices : 1];
+            setSize = new int[g.numVertices > 0 ? g.numVertices : 1];
+            crossTails = new IntList[numWorkers];
+            crossHeads = new IntList[numWorkers];
+        }
+
+        ~ComponentsWork() {
+            delete[] parent;
+            delete[] setSize;
+            delete[] crossTails;
+            delete[] crossHeads;
+        }
+
+        int first(int worker) const {
+            return (int)((long long)graph.numVertices * worker / numWorkers);
+        }
+
+    private:
+        ComponentsWork(const ComponentsWork&);
+        ComponentsWork& operator=(const ComponentsWork&);
+    };
+
+    static void uniteWithinRange(void* context, int worker) {
+        ComponentsWork& work = *(ComponentsWork*)context;
+        const CSRGraph& g = work.graph;
+        int first = work.first(worker), end = work.first(worker + 1);
+        for (int i = first; i < end; ++i) {
+            work.parent[i] = i;
+            work.setSize[i] = 1;
+        }
+        for (int u = first; u < end; ++u) {
+            for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) {
+                int v = g.edgeTargets[e];
+                if (v >= first && v < end) {
+                    unite(work.parent, work.setSize, u, v);
+                } else {
+                    work.crossTails[worker].push(u);
+                    work.crossHeads[worker].push(v);
+                }
+            }
+        }
+    }
+
+    static void rootsInRange(void* context, int worker) {
+        ComponentsWork& work = *(ComponentsWork*)context;
+        for (int v = work.first(worker); v < work.first(worker + 1); ++v) {
+            int root = v;
+            while (work.parent[root] != root) root = work.parent[root];
+            work.component[v] = root;
+        }
+    }
+
+    void Dijkstra(int startVertexID) const {
+        int start = indexOf(startVertexID);
+        if (start == -1) {
+            cout << "Dijkstra Error: Start vertex " << startVertexID << " not found." << endl;
+            return;
+        }
+        int* dist = new int[numVertices];
+        computeDistances(start, dist);
+
+        cout << "Dijkstra's Shortest Paths from Vertex " << startVertexID << ":" << endl;
+        cout << "Vertex distances from " << startVertexID << ":" << endl;
+        for (int i = numVertices - 1; i >= 0; --i) { // Same order as Graph's vertex list (newest first)
+            cout << "  To " << vertexIDs[i] << " (" << vertexName(i) << "): ";
+            if (dist[i] == 2147483647) {
+                cout << "Not Reachable" << endl;
+            } else {
+                cout << dist[i] << endl;
+            }
+        }
+        delete[] dist;
+    }
+
+private:
+    static long long padded(long long bytes) {
+        return (bytes + 7) / 8 * 8;
+    }
+
+    static void writeSection(ofstream& out, const void* data, long long bytes) {
+        static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        if (bytes > 0) out.write((const char*)data, bytes);
+        out.write(zeros, padded(bytes) - bytes);
+    }
+
+    char* takeSection(long long& cursor, long long bytes) {
+        char* section = fileBuffer + cursor;
+        cursor += padded(bytes);
+        return section;
+    }
+
+    // The reverse CSR must describe exactly the forward roads: per vertex the same number of
+    // in-arcs and the same order-independent checksum over their (tail, weight) pairs
+    bool reverseMatchesForward() const {
+        int size = numVertices > 0 ? numVertices : 1;
+        unsigned long long* expected = new unsigned long long[size];
+        int* inDegree = new int[size];
+        for (int v = 0; v < numVertices; ++v) {
+            expected[v] = 0;
+            inDegree[v] = 0;
+        }
+        for (int u = 0; u < numVertices; ++u) {
+            for (int e = edgeOffsets[u]; e < edgeOffsets[u + 1]; ++e) {
+                expected[edgeTargets[e]] += arcChecksum(u, edgeWeights[e]);
+                inDegree[edgeTargets[e]]++;
+            }
+        }
+        bool valid = true;
+        for (int v = 0; valid && v < numVertices; ++v) {
+            unsigned long long sum = 0;
+            for (int e = inOffsets[v]; e < inOffsets[v + 1]; ++e) sum += arcChecksum(inSources[e], inWeights[e]);
+            valid = inOffsets[v + 1] - inOffsets[v] == inDegree[v] && sum == expected[v];
+        }
+        delete[] expected;
+        delete[] inDegree;
+        return valid;
+    }
+
+    static unsigned long long arcChecksum(int tail, int weight) { // splitmix64 finalizer
+        unsigned long long x = ((unsigned long long)(unsigned int)tail << 32) | (unsigned int)weight;
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    bool validOffsets(const int* outOffsets, const int* outHeads, const int* revOffsets, const int* revHeads) const {
+        if (outOffsets[0] != 0 || revOffsets[0] != 0 || outOffsets[numVertices] != numEdges || revOffsets[numVertices] != numEdges) return false;
+        for (int i = 0; i < numVertices; ++i) {
+            if (outOffsets[i + 1] < outOffsets[i] || revOffsets[i + 1] < revOffsets[i]) return false;
+        }
+        for (int e = 0; e < numEdges; ++e) {
+            if (outHeads[e] < 0 || outHeads[e] >= numVertices || revHeads[e] < 0 || revHeads[e] >= numVertices) return false;
+        }
+        return true;
+    }
+};
+
+
+// --- AMBITIOUS FEATURE: Contraction Hierarchies ---
+// Preprocessing contracts vertices one by one (cheapest first by edge difference), adding a
+// shortcut u->w whenever u->v->w is the only shortest path (no "witness" path avoiding v).
+// The result keeps, for every vertex, only the arcs leading to higher-ranked vertices:
+// upward out-arcs for the forward search and upward in-arcs for the backward search.
+// A query is a bidirectional Dijkstra that only ever climbs, so it settles a few hundred
+// vertices even on large networks.
+
+// Arc of the contraction graph; middle is the contracted vertex a shortcut skips (-1 = original road)
+struct CHArc {
+    int other;
+    int weight;
+    int middle;
+};
+
+class CHArcList {
+public:
+    CHArc* arcs;
+    int size;
+    int capacity;
+
+    CHArcList() : arcs(NULL), size(0), capacity(0) {}
+
+    ~CHArcList() {
+        delete[] arcs;
+    }
+
+    int find(int other) const {
+        for (int i = 0; i < size; ++i) {
+            if (arcs[i].other == other) return i;
+        }
+        return -1;
+    }
+
+    // Keeps a single arc per neighbor, with the smallest weight
+    void addOrImprove(int other, int weight, int middle) {
+        int existing = find(other);
+        if (existing != -1) {
+            if (weight < arcs[existing].weight) {
+                arcs[existing].weight = weight;
+                arcs[existing].middle = middle;
+            }
+            return;
+        }
+        if (size == capacity) {
+            int newCapacity = capacity == 0 ? 4 : capacity * 2;
+            CHArc* bigger = new CHArc[newCapacity];
+            for (int i = 0; i < size; ++i) bigger[i] = arcs[i];
+            delete[] arcs;
+            arcs = bigger;
+            capacity = newCapacity;
+        }
+        arcs[size].other = other;
+        arcs[size].weight = weight;
+        arcs[size].middle = middle;
+        size++;
+    }
+
+    void remove(int other) {
+        int existing = find(other);
+        if (existing == -1) return;
+        arcs[existing] = arcs[size - 1];
+        size--;
+    }
+};
+
+class ContractionHierarchy {
+public:
+    int numVertices;
+    int* vertexIDs;
+    int* rank;            // Contraction order, 0 = contracted first
+    int* upOffsets;       // Upward forward graph: arcs v -> w with rank[w] > rank[v]
+    int* upTargets;
+    int* upWeights;
+    int* upMiddle;
+    int* downOffsets;     // Upward backward graph: arcs u -> v with rank[u] > rank[v], stored at v
+    int* downSources;
+    int* downWeights;
+    int* downMiddle;
+    int numShortcuts;
+    unsigned int sourceFingerprint; // CSRGraph::fingerprint() of the graph it was built from
+    VertexIndexMap idIndex;
+
+    // Witness searches give up after this many settled vertices (a missed witness only costs
+    // an unnecessary shortcut, never a wrong answer). Priority estimates use the cheaper limit.
+    static const int WITNESS_SETTLE_LIMIT = 200;
+    static const int ESTIMATE_SETTLE_LIMIT = 20;
+
+    ContractionHierarchy() : numVertices(0), vertexIDs(NULL), rank(NULL), upOffsets(NULL), upTargets(NULL), upWeights(NULL), upMiddle(NULL),
+                             downOffsets(NULL), downSources(NULL), downWeights(NULL), downMiddle(NULL), numShortcuts(0), sourceFingerprint(0) {}
+
+    ~ContractionHierarchy() {
+        release();
+    }
+
+    void release() {
+        delete[] vertexIDs;
+        delete[] rank;
+        delete[] upOffsets;
+        delete[] upTargets;
+        delete[] upWeights;
+        delete[] upMiddle;
+        delete[] downOffsets;
+        delete[] downSources;
+        delete[] downWeights;
+        delete[] downMiddle;
+        vertexIDs = rank = upOffsets = upTargets = upWeights = upMiddle = NULL;
+        downOffsets = downSources = downWeights = downMiddle = NULL;
+        numVertices = 0;
+        numShortcuts = 0;
+        idIndex.clear();
+    }
+
+    int indexOf(int vertexID) const {
+        return idIndex.find(vertexID);
+    }
+
+    // --- Preprocessing ---
+    void build(const CSRGraph& graph) {
+        release();
+        numVertices = graph.numVertices;
+        sourceFingerprint = graph.fingerprint();
+        int n = numVertices;
+        vertexIDs = new int[n > 0 ? n : 1];
+        rank = new int[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) {
+            vertexIDs[i] = graph.vertexIDs[i];
+            idIndex.insert(graph.vertexIDs[i], i);
+        }
+
+        // Remaining (not yet contracted) graph, with parallel roads merged
+        CHArcList* outArcs = new CHArcList[n > 0 ? n : 1];
+        CHArcList* inArcs = new CHArcList[n > 0 ? n : 1];
+        for (int u = 0; u < n; ++u) {
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                int v = graph.edgeTargets[e];
+                if (v == u) continue; // Self loops never lie on a shortest path
+                outArcs[u].addOrImprove(v, graph.edgeWeights[e], -1);
+                inArcs[v].addOrImprove(u, graph.edgeWeights[e], -1);
+            }
+        }
+
+        // Arcs frozen into the hierarchy when their lower endpoint is contracted
+        CHArcList* finalUp = new CHArcList[n > 0 ? n : 1];
+        CHArcList* finalDown = new CHArcList[n > 0 ? n : 1];
+
+        int* deletedNeighbors = new int[n > 0 ? n : 1];
+        int* level = new int[n > 0 ? n : 1];
+        int* lastRefreshed = new int[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) {
+            deletedNeighbors[i] = 0;
+            level[i] = 0;
+            lastRefreshed[i] = -1;
+        }
+
+        SearchWorkspace witness(n);
+        IndexedDaryHeap order(n, 4);
+        for (int v = 0; v < n; ++v) {
+            order.push(v, contractionPriority(v, outArcs, inArcs, deletedNeighbors, level, witness));
+        }
+
+        int nextRank = 0;
+        while (!order.isEmpty()) {
+            int v = order.pop();
+            // Lazy update: priorities of untouched vertices may be stale
+            int current = contractionPriority(v, outArcs, inArcs, deletedNeighbors, level, witness);
+            if (!order.isEmpty() && current > order.topPriority()) {
+                order.push(v, current);
+                continue;
+            }
+
+            for (int i = 0; i < outArcs[v].size; ++i) finalUp[v].addOrImprove(outArcs[v].arcs[i].other, outArcs[v].arcs[i].weight, outArcs[v].arcs[i].middle);
+            for (int i = 0; i < inArcs[v].size; ++i) finalDown[v].addOrImprove(inArcs[v].arcs[i].other, inArcs[v].arcs[i].weight, inArcs[v].arcs[i].middle);
+
+            numShortcuts += contractVertex(v, outArcs, inArcs, witness, true);
+            rank[v] = nextRank++;
+
+            // Detach v and refresh its neighbors
+            for (int i = 0; i < outArcs[v].size; ++i) {
+                int w = outArcs[v].arcs[i].other;
+                inArcs[w].remove(v);
+                deletedNeighbors[w]++;
+                if (level[w] < level[v] + 1) level[w] = level[v] + 1;
+            }
+            for (int i = 0; i < inArcs[v].size; ++i) {
+                int u = inArcs[v].arcs[i].other;
+                outArcs[u].remove(v);
+                deletedNeighbors[u]++;
+                if (level[u] < level[v] + 1) level[u] = level[v] + 1;
+            }
+            // A two-way road makes the same neighbor appear in both lists; refresh it once
+            for (int i = 0; i < outArcs[v].size; ++i) {
+                int w = outArcs[v].arcs[i].other;
+                lastRefreshed[w] = v;
+                order.update(w, contractionPriority(w, outArcs, inArcs, deletedNeighbors, level, witness));
+            }
+            for (int i = 0; i < inArcs[v].size; ++i) {
+                int u = inArcs[v].arcs[i].other;
+                if (lastRefreshed[u] == v) continue;
+                order.update(u, contractionPriority(u, outArcs, inArcs, deletedNeighbors, level, witness));
+            }
+            outArcs[v].size = 0;
+            inArcs[v].size = 0;
+        }
+
+        flatten(finalUp, upOffsets, upTargets, upWeights, upMiddle);
+        flatten(finalDown, downOffsets, downSources, downWeights, downMiddle);
+
+        delete[] outArcs;
+        delete[] inArcs;
+        delete[] finalUp;
+        delete[] finalDown;
+        delete[] deletedNeighbors;
+        delete[] level;
+        delete[] lastRefreshed;
+    }
+
+    // --- Query: upward bidirectional Dijkstra ---
+    RouteResult query(int sourceID, int targetID, SearchWorkspace& forward, SearchWorkspace& backward) const {
+        RouteResult result;
+        int source = indexOf(sourceID);
+        int target = indexOf(targetID);
+        if (source == -1 || target == -1) return result;
+
+        forward.beginSearch();
+        backward.beginSearch();
+        forward.setDist(source, 0, -1);
+        forward.heap.push(source, 0);
+        backward.setDist(target, 0, -1);
+        backward.heap.push(target, 0);
+        int best = INFINITY_DIST;
+        int meet = -1;
+
+        bool forwardTurn = true;
+        while (!forward.heap.isEmpty() || !backward.heap.isEmpty()) {
+            if (forward.heap.isEmpty()) forwardTurn = false;
+            else if (backward.heap.isEmpty()) forwardTurn = true;
+            SearchWorkspace& ws = forwardTurn ? forward : backward;
+            SearchWorkspace& other = forwardTurn ? backward : forward;
+            const int* offsets = forwardTurn ? upOffsets : downOffsets;
+            const int* heads = forwardTurn ? upTargets : downSources;
+            const int* weights = forwardTurn ? upWeights : downWeights;
+            forwardTurn = !forwardTurn;
+
+            if (ws.heap.topPriority() >= best) { // This side cannot improve the answer any more
+                ws.heap.clear();
+                continue;
+            }
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            int du = ws.getDist(u);
+            int otherDist = other.getDist(u);
+            if (otherDist != INFINITY_DIST && du + otherDist < best) {
+                best = du + otherDist;
+                meet = u;
+            }
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = heads[e];
+                int newDist = du + weights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+
+        result.settledCount = forward.settledCount + backward.settledCount;
+        if (meet == -1) return result;
+
+        // Hierarchy path source .. meet .. target, then expand every shortcut
+        IntList hops;
+        for (int v = meet; v != -1; v = forward.getParent(v)) hops.push(v);
+        for (int i = 0, j = hops.size - 1; i < j; ++i, --j) {
+            int tmp = hops.data[i];
+            hops.data[i] = hops.data[j];
+            hops.data[j] = tmp;
+        }
+        for (int v = backward.getParent(meet); v != -1; v = backward.getParent(v)) hops.push(v);
+
+        IntList path;
+        path.push(hops.data[0]);
+        for (int i = 0; i + 1 < hops.size; ++i) unpackArc(hops.data[i], hops.data[i + 1], path);
+
+        result.allocatePath(path.size);
+        for (int i = 0; i < path.size; ++i) result.pathIDs[i] = vertexIDs[path.data[i]];
+        result.found = true;
+        result.cost = best;
+        return result;
+    }
+
+    // --- Many-to-many: bucket-based distance table ---
+    // One backward upward search per target leaves (target, dist) entries in a bucket at every
+    // vertex it reaches; one forward upward search per source then only has to scan the buckets
+    // of the vertices it reaches. Each search is a few hundred vertices, so a 100 x 1000 table
+    // costs ~1100 small searches instead of 100 full Dijkstra runs.
+    DistanceMatrix distanceMatrix(const int* sourceIDs, int numSources, const int* targetIDs, int numTargets,
+                                  SearchWorkspace& ws) const {
+        DistanceMatrix matrix(numSources, numTargets);
+        int n = numVertices;
+
+        // Backward phase: collect (vertex, column, dist) triples
+        IntList settledOrder;
+        IntList entryVertex, entryColumn, entryDist;
+        for (int j = 0; j < numTargets; ++j) {
+            int target = indexOf(targetIDs[j]);
+            if (target == -1) continue;
+            upwardSearch(target, downOffsets, downSources, downWeights, upOffsets, upTargets, upWeights, ws, settledOrder);
+            for (int i = 0; i < settledOrder.size; ++i) {
+                int v = settledOrder.data[i];
+                entryVertex.push(v);
+                entryColumn.push(j);
+                entryDist.push(ws.getDist(v));
+            }
+        }
+
+        // Group entries by vertex (counting sort) so a forward search reads one contiguous bucket
+        int* bucketOffsets = new int[n + 1];
+        for (int v = 0; v <= n; ++v) bucketOffsets[v] = 0;
+        for (int i = 0; i < entryVertex.size; ++i) bucketOffsets[entryVertex.data[i] + 1]++;
+        for (int v = 0; v < n; ++v) bucketOffsets[v + 1] += bucketOffsets[v];
+        int total = entryVertex.size;
+        int* bucketColumn = new int[total > 0 ? total : 1];
+        int* bucketDist = new int[total > 0 ? total : 1];
+        int* fill = new int[n > 0 ? n : 1];
+        for (int v = 0; v < n; ++v) fill[v] = bucketOffsets[v];
+        for (int i = 0; i < total; ++i) {
+            int slot = fill[entryVertex.data[i]]++;
+            bucketColumn[slot] = entryColumn.data[i];
+            bucketDist[slot] = entryDist.data[i];
+        }
+        delete[] fill;
+
+        // Forward phase
+        for (int i = 0; i < numSources; ++i) {
+            int source = indexOf(sourceIDs[i]);
+            if (source == -1) continue;
+            upwardSearch(source, upOffsets, upTargets, upWeights, downOffsets, downSources, downWeights, ws, settledOrder);
+            int* row = matrix.values + (long long)i * numTargets;
+            for (int k = 0; k < settledOrder.size; ++k) {
+                int v = settledOrder.data[k];
+                int dv = ws.getDist(v);
+                for (int b = bucketOffsets[v]; b < bucketOffsets[v + 1]; ++b) {
+                    int candidate = dv + bucketDist[b];
+                    if (candidate < row[bucketColumn[b]]) row[bucketColumn[b]] = candidate;
+                }
+            }
+        }
+
+        delete[] bucketOffsets;
+        delete[] bucketColumn;
+        delete[] bucketDist;
+        return matrix;
+    }
+
+    // --- Persistence (binary, host byte order) ---
+    bool saveToFile(const string& filename) const {
+        ofstream out(filename.c_str(), ios::binary);
+        if (!out) return false;
+        int upCount = upOffsets[numVertices];
+        int downCount = downOffsets[numVertices];
+        out.write("CHv1", 4);
+        writeInts(out, &numVertices, 1);
+        writeInts(out, &upCount, 1);
+        writeInts(out, &downCount, 1);
+        writeInts(out, &numShortcuts, 1);
+        out.write((const char*)&sourceFingerprint, sizeof(sourceFingerprint));
+        writeInts(out, vertexIDs, numVertices);
+        writeInts(out, rank, numVertices);
+        writeInts(out, upOffsets, numVertices + 1);
+        writeInts(out, upTargets, upCount);
+        writeInts(out, upWeights, upCount);
+        writeInts(out, upMiddle, upCount);
+        writeInts(out, downOffsets, numVertices + 1);
+        writeInts(out, downSources, downCount);
+        writeInts(out, downWeights, downCount);
+        writeInts(out, downMiddle, downCount);
+        return (bool)out;
+    }
+
+    bool loadFromFile(const string& filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in) return false;
+        char magic[4];
+        in.read(magic, 4);
+        if (!in || magic[0] != 'C' || magic[1] != 'H' || magic[2] != 'v' || magic[3] != '1') return false;
+
+        release();
+        int upCount = 0, downCount = 0;
+        readInts(in, &numVertices, 1);
+        readInts(in, &upCount, 1);
+        readInts(in, &downCount, 1);
+        readInts(in, &numShortcuts, 1);
+        in.read((char*)&sourceFingerprint, sizeof(sourceFingerprint));
+        if (!in || numVertices < 0 || upCount < 0 || downCount < 0) {
+            release();
+            return false;
+        }
+        int n = numVertices;
+        vertexIDs = new int[n > 0 ? n : 1];
+        rank = new int[n > 0 ? n : 1];
+        upOffsets = new int[n + 1];
+        upTargets = new int[upCount > 0 ? upCount : 1];
+        upWeights = new int[upCount > 0 ? upCount : 1];
+        upMiddle = new int[upCount > 0 ? upCount : 1];
+        downOffsets = new int[n + 1];
+        downSources = new int[downCount > 0 ? downCount : 1];
+        downWeights = new int[downCount > 0 ? downCount : 1];
+        downMiddle = new int[downCount > 0 ? downCount : 1];
+        readInts(in, vertexIDs, n);
+        readInts(in, rank, n);
+        readInts(in, upOffsets, n + 1);
+        readInts(in, upTargets, upCount);
+        readInts(in, upWeights, upCount);
+        readInts(in, upMiddle, upCount);
+        readInts(in, downOffsets, n + 1);
+        readInts(in, downSources, downCount);
+        readInts(in, downWeights, downCount);
+        readInts(in, downMiddle, downCount);
+        if (!in || !validHierarchy(upCount, downCount)) {
+            release();
+            return false;
+        }
+        for (int i = 0; i < n; ++i) idIndex.insert(vertexIDs[i], i);
+        return true;
+    }
+
+private:
+    // Checks everything query() and unpackArc() index with: ranks form a permutation, offsets
+    // are monotone and cover the arc arrays, every arc climbs in rank, weights are non-negative,
+    // and a shortcut's middle vertex ranks below both ends (so unpacking terminates)
+    bool validHierarchy(int upCount, int downCount) const {
+        int n = numVertices;
+        if (upOffsets[0] != 0 || upOffsets[n] != upCount || downOffsets[0] != 0 || downOffsets[n] != downCount) return false;
+        bool* rankUsed = new bool[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) rankUsed[i] = false;
+        bool valid = true;
+        for (int v = 0; valid && v < n; ++v) {
+            if (rank[v] < 0 || rank[v] >= n || rankUsed[rank[v]]) valid = false;
+            else rankUsed[rank[v]] = true;
+        }
+        delete[] rankUsed;
+        for (int v = 0; valid && v < n; ++v) {
+            if (upOffsets[v + 1] < upOffsets[v] || downOffsets[v + 1] < downOffsets[v]) valid = false;
+        }
+        for (int v = 0; valid && v < n; ++v) {
+            for (int e = upOffsets[v]; valid && e < upOffsets[v + 1]; ++e) {
+                valid = validArc(v, upTargets[e], upWeights[e], upMiddle[e]);
+            }
+            for (int e = downOffsets[v]; valid && e < downOffsets[v + 1]; ++e) {
+                valid = validArc(v, downSources[e], downWeights[e], downMiddle[e]);
+            }
+        }
+        return valid;
+    }
+
+    // Arc stored at v towards (or from) the higher-ranked vertex other
+    bool validArc(int v, int other, int weight, int middle) const {
+        if (other < 0 || other >= numVertices || rank[other] <= rank[v] || weight < 0) return false;
+        return middle == -1 || (middle >= 0 && middle < numVertices && rank[middle] < rank[v]);
+    }
+
+    // Complete search over one direction of the hierarchy with stall-on-demand: a vertex that
+    // a higher-ranked settled neighbour reaches more cheaply (via the opposite-direction arcs)
+    // cannot be on a shortest up-down path, so it is neither expanded nor reported.
+    // settledOrder receives the remaining settled vertices in order
+    void upwardSearch(int start, const int* offsets, const int* heads, const int* weights,
+                      const int* stallOffsets, const int* stallHeads, const int* stallWeights,
+                      SearchWorkspace& ws, IntList& settledOrder) const {
+        settledOrder.clear();
+        ws.beginSearch();
+        ws.setDist(start, 0, -1);
+        ws.heap.push(start, 0);
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            int du = ws.getDist(u);
+            bool stalled = false;
+            for (int e = stallOffsets[u]; e < stallOffsets[u + 1] && !stalled; ++e) {
+                int dw = ws.getDist(stallHeads[e]);
+                if (dw != INFINITY_DIST && dw + stallWeights[e] < du) stalled = true;
+            }
+            if (stalled) continue;
+            settledOrder.push(u);
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = heads[e];
+                int newDist = du + weights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+    }
+
+    static void writeInts(ofstream& out, const int* values, int count) {
+        if (count > 0) out.write((const char*)values, sizeof(int) * count);
+    }
+
+    static void readInts(ifstream& in, int* values, int count) {
+        if (count > 0) in.read((char*)values, sizeof(int) * count);
+    }
+
+    // Local Dijkstra from 'from' in the remaining graph, never entering 'skip'
+    static void witnessSearch(int from, int skip, int maxDist, int settleLimit, CHArcList* outArcs, SearchWorkspace& ws) {
+        ws.beginSearch();
+        ws.setDist(from, 0, -1);
+        ws.heap.push(from, 0);
+        while (!ws.heap.isEmpty() && ws.settledCount < settleLimit) {
+            if (ws.heap.topPriority() > maxDist) break;
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            int du = ws.getDist(u);
+            for (int i = 0; i < outArcs[u].size; ++i) {
+                int v = outArcs[u].arcs[i].other;
+                if (v == skip) continue;
+                int newDist = du + outArcs[u].arcs[i].weight;
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+    }
+
+    // Returns the number of shortcuts contracting v needs; adds them when apply is true
+    static int contractVertex(int v, CHArcList* outArcs, CHArcList* inArcs, SearchWorkspace& ws, bool apply) {
+        int shortcuts = 0;
+        for (int i = 0; i < inArcs[v].size; ++i) {
+            int u = inArcs[v].arcs[i].other;
+            int toV = inArcs[v].arcs[i].weight;
+            int maxDist = -1;
+            for (int j = 0; j < outArcs[v].size; ++j) {
+                if (outArcs[v].arcs[j].other != u && toV + outArcs[v].arcs[j].weight > maxDist) {
+                    maxDist = toV + outArcs[v].arcs[j].weight;
+                }
+            }
+            if (maxDist < 0) continue; // No out-neighbor other than u itself
+            witnessSearch(u, v, maxDist, apply ? WITNESS_SETTLE_LIMIT : ESTIMATE_SETTLE_LIMIT, outArcs, ws);
+            for (int j = 0; j < outArcs[v].size; ++j) {
+                int w = outArcs[v].arcs[j].other;
+                if (w == u) continue;
+                int viaV = toV + outArcs[v].arcs[j].weight;
+                if (ws.getDist(w) <= viaV) continue; // Witness found
+                shortcuts++;
+                if (apply) {
+                    outArcs[u].addOrImprove(w, viaV, v);
+                    inArcs[w].addOrImprove(u, viaV, v);
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    static int contractionPriority(int v, CHArcList* outArcs, CHArcList* inArcs, int* deletedNeighbors, int* level, SearchWorkspace& ws) {
+        int shortcuts = contractVertex(v, outArcs, inArcs, ws, false);
+        int edgeDifference = shortcuts - outArcs[v].size - inArcs[v].size;
+        return 2 * edgeDifference + deletedNeighbors[v] + level[v];
+    }
+
+    void flatten(CHArcList* lists, int*& offsets, int*& heads, int*& weights, int*& middles) {
+        int total = 0;
+        offsets = new int[numVertices + 1];
+        for (int v = 0; v < numVertices; ++v) {
+            offsets[v] = total;
+            total += lists[v].size;
+        }
+        offsets[numVertices] = total;
+        heads = new int[total > 0 ? total : 1];
+        weights = new int[total > 0 ? total : 1];
+        middles = new int[total > 0 ? total : 1];
+        for (int v = 0; v < numVertices; ++v) {
+            for (int i = 0; i < lists[v].size; ++i) {
+                heads[offsets[v] + i] = lists[v].arcs[i].other;
+                weights[offsets[v] + i] = lists[v].arcs[i].weight;
+                middles[offsets[v] + i] = lists[v].arcs[i].middle;
+            }
+        }
+    }
+
+    // Middle vertex of the hierarchy arc a -> b (-1 for an original road)
+    int arcMiddle(int a, int b) const {
+        if (rank[a] < rank[b]) {
+            for (int e = upOffsets[a]; e < upOffsets[a + 1]; ++e) {
+                if (upTargets[e] == b) return upMiddle[e];
+            }
+        } else {
+            for (int e = downOffsets[b]; e < downOffsets[b + 1]; ++e) {
+                if (downSources[e] == a) return downMiddle[e];
+            }
+        }
+        return -1;
+    }
+
+    // Appends the original vertices after a on the road a -> b (b included)
+    void unpackArc(int a, int b, IntList& path) const {
+        int middle = arcMiddle(a, b);
+        if (middle == -1) {
+            path.push(b);
+            return;
+        }
+        unpackArc(a, middle, path);
+        unpackArc(middle, b, path);
+    }
+};
+
+
+// --- AMBITIOUS FEATURE: ALT routing (A*, Landmarks, Triangle inequality) ---
+// K landmarks are picked by farthest-point selection and exact distances to and from each
+// one are stored. For any vertex v and target t the triangle inequality gives
+//   d(v,t) >= d(v,L) - d(t,L)   and   d(v,t) >= d(L,t) - d(L,v)
+// and the largest of these bounds drives an A* search. Unlike a ContractionHierarchy the
+// tables are cheap to refresh after weight changes: rebuildStep() redoes one landmark at a
+// time so the work can be spread over idle moments, and the old tables stay in use until
+// the new set is complete.
+class LandmarkIndex {
+public:
+    int numVertices;
+    int requestedLandmarks;
+    int numLandmarks;     // Can be fewer than requested on tiny graphs
+    int* landmarks;       // Dense vertex index of each landmark
+    int* distFrom;        // distFrom[k * numVertices + v] = d(landmark k, v)
+    int* distTo;          // distTo[k * numVertices + v] = d(v, landmark k)
+    bool ready;
+
+    // Rebuild in progress (swapped in when every landmark is done)
+    const CSRGraph* pendingGraph;
+    int pendingDone;
+    int* pendingLandmarks;
+    int* pendingFrom;
+    int* pendingTo;
+
+    LandmarkIndex(int k = 8) : numVertices(0), requestedLandmarks(k < 1 ? 1 : k), numLandmarks(0), landmarks(NULL), distFrom(NULL), distTo(NULL), ready(false),
+                               pendingGraph(NULL), pendingDone(0), pendingLandmarks(NULL), pendingFrom(NULL), pendingTo(NULL) {}
+
+    ~LandmarkIndex() {
+        delete[] landmarks;
+        delete[] distFrom;
+        delete[] distTo;
+        discardPending();
+    }
+
+    bool isRebuilding() const {
+        return pendingGraph != NULL;
+    }
+
+    // Starts a rebuild against 'graph'; the graph must outlive the rebuild
+    void beginRebuild(const CSRGraph& graph) {
+        discardPending();
+        pendingGraph = &graph;
+        pendingDone = 0;
+        int n = graph.numVertices;
+        int k = requestedLandmarks < n ? requestedLandmarks : (n > 0 ? n : 1);
+        pendingLandmarks = new int[k];
+        pendingFrom = new int[(long long)k * (n > 0 ? n : 1)];
+        pendingTo = new int[(long long)k * (n > 0 ? n : 1)];
+    }
+
+    // Computes the next landmark's tables. Returns true once the new set has been swapped in.
+    bool rebuildStep() {
+        if (!pendingGraph) return ready;
+        const CSRGraph& graph = *pendingGraph;
+        int n = graph.numVertices;
+        int k = requestedLandmarks < n ? requestedLandmarks : n;
+        if (pendingDone < k) {
+            int landmark = pickFarthest(graph);
+            pendingLandmarks[pendingDone] = landmark;
+            graph.computeDistances(landmark, pendingFrom + (long long)pendingDone * n);
+            graph.computeDistances(landmark, pendingTo + (long long)pendingDone * n, true);
+            pendingDone++;
+        }
+        if (pendingDone < k) return false;
+
+        delete[] landmarks;
+        delete[] distFrom;
+        delete[] distTo;
+        landmarks = pendingLandmarks;
+        distFrom = pendingFrom;
+        distTo = pendingTo;
+        numVertices = n;
+        numLandmarks = k;
+        ready = n > 0;
+        pendingLandmarks = pendingFrom = pendingTo = NULL;
+        pendingGraph = NULL;
+        return ready;
+    }
+
+    void build(const CSRGraph& graph) {
+        beginRebuild(graph);
+        while (!rebuildStep() && isRebuilding()) {}
+    }
+
+    // Largest landmark lower bound on d(v, target)
+    int lowerBound(int v, int target) const {
+        int best = 0;
+        for (int k = 0; k < numLandmarks; ++k) {
+            const int* from = distFrom + (long long)k * numVertices;
+            const int* to = distTo + (long long)k * numVertices;
+            if (to[v] != INFINITY_DIST && to[target] != INFINITY_DIST && to[v] - to[target] > best) {
+                best = to[v] - to[target];
+            }
+            if (from[target] != INFINITY_DIST && from[v] != INFINITY_DIST && from[target] - from[v] > best) {
+                best = from[target] - from[v];
+            }
+        }
+        return best;
+    }
+
+    // A* on 'graph' guided by the landmark bounds; graph must be the one the tables were built on
+    RouteResult query(const CSRGraph& graph, int sourceID, int targetID, SearchWorkspace& ws) const {
+        RouteResult result;
+        int source = graph.indexOf(sourceID);
+        int target = graph.indexOf(targetID);
+        if (source == -1 || target == -1 || !ready) return result;
+
+        ws.beginSearch();
+        ws.setDist(source, 0, -1);
+        ws.heap.push(source, lowerBound(source, target));
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == target) break;
+            int du = ws.getDist(u);
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                int v = graph.edgeTargets[e];
+                int newDist = du + graph.edgeWeights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist + lowerBound(v, target));
+                }
+            }
+        }
+        result.settledCount = ws.settledCount;
+        graph.buildRoute(ws, target, result);
+        return result;
+    }
+
+private:
+    void discardPending() {
+        delete[] pendingLandmarks;
+        delete[] pendingFrom;
+        delete[] pendingTo;
+        pendingLandmarks = pendingFrom = pendingTo = NULL;
+        pendingGraph = NULL;
+        pendingDone = 0;
+    }
+
+    // Vertex whose distance to the nearest already-chosen landmark is largest.
+    // The first landmark is the vertex farthest from vertex 0.
+    int pickFarthest(const CSRGraph& graph) {
+        int n = graph.numVertices;
+        int* fromZero = NULL;
+        if (pendingDone == 0) {
+            fromZero = new int[n];
+            graph.computeDistances(0, fromZero);
+        }
+        int bestVertex = 0;
+        int bestDist = -1;
+        for (int v = 0; v < n; ++v) {
+            int nearest;
+            if (fromZero) {
+                nearest = fromZero[v];
+            } else {
+                nearest = INFINITY_DIST;
+                for (int k = 0; k < pendingDone; ++k) {
+                    int d = pendingFrom[(long long)k * n + v];
+                    if (d < nearest) nearest = d;
+                }
+            }
+            if (nearest == INFINITY_DIST) continue; // Unreached: no useful bound through it anyway
+            bool alreadyChosen = false;
+            for (int k = 0; k < pendingDone; ++k) {
+                if (pendingLandmarks[k] == v) alreadyChosen = true;
+            }
+            if (!alreadyChosen && nearest > bestDist) {
+                bestDist = nearest;
+                bestVertex = v;
+            }
+        }
+        delete[] fromZero;
+        return bestVertex;
+    }
+};
+
+
+// --- AMBITIOUS FEATURE: Delta-stepping single-source shortest paths ---
+// Vertices are kept in buckets of width delta by tentative distance. A bucket is emptied in
+// phases that relax only "light" edges (weight <= delta), since those can refill the same
+// bucket; "heavy" edges are relaxed once per bucket afterwards. Every vertex in a bucket can
+// be processed independently, so the phases run on numThreads workers. Vertex v belongs to
+// worker v % numThreads, which keeps its bucket entries and is the only one writing dist[v]:
+// a phase first has every worker scan its own part of the bucket and append relaxation
+// requests (v, newDist) to a per-(worker, owner) buffer, then, after a barrier, each owner
+// applies the requests addressed to it. No locks or atomics are needed on dist[].
+// Buckets are reused cyclically: relaxing from bucket i never lands further than
+// i + 1 + maxWeight / delta, so maxWeight / delta + 2 slots are enough.
+class DeltaSteppingSSSP {
+public:
+    const CSRGraph& graph;
+    int delta;
+    int numThreads;
+    int maxWeight;
+    int numBuckets;
+    IntList* buckets;          // buckets[t * numBuckets + b]: slot b of worker t's vertices
+    IntList* frontiers;        // Per worker: its part of the bucket being processed in the current phase
+    IntList* settledInBucket;  // Per worker: vertices removed from the current bucket (for heavy relaxation)
+    IntList* requestTargets;   // [from * numThreads + owner]: requests generated by worker 'from'
+    IntList* requestDists;     // for vertices of 'owner', applied by the owner after the next barrier
+    long long* workerRelaxations;
+    int* memberStamp;          // memberStamp[v] == bucket + 1 when v is already in its owner's settledInBucket
+    long long relaxations;     // Statistics of the last run
+    int phases;
+
+    DeltaSteppingSSSP(const CSRGraph& g, int bucketWidth, int threads = 1)
+        : graph(g), delta(bucketWidth < 1 ? 1 : bucketWidth), numThreads(threads < 1 ? 1 : threads), maxWeight(0), relaxations(0), phases(0),
+          dist(NULL), current(0), step(STEP_LIGHT), barrier(numThreads) {
+        for (int e = 0; e < graph.numEdges; ++e) {
+            if (graph.edgeWeights[e] > maxWeight) maxWeight = graph.edgeWeights[e];
+        }
+        numBuckets = maxWeight / delta + 2;
+        buckets = new IntList[numThreads * numBuckets];
+        frontiers = new IntList[numThreads];
+        settledInBucket = new IntList[numThreads];
+        requestTargets = new IntList[numThreads * numThreads];
+        requestDists = new IntList[numThreads * numThreads];
+        workerRelaxations = new long long[numThreads];
+        memberStamp = new int[graph.numVertices > 0 ? graph.numVertices : 1];
+    }
+
+    ~DeltaSteppingSSSP() {
+        delete[] buckets;
+        delete[] frontiers;
+        delete[] settledInBucket;
+        delete[] requestTargets;
+        delete[] requestDists;
+        delete[] workerRelaxations;
+        delete[] memberStamp;
+    }
+
+    // Same contract as CSRGraph::computeDistances
+    void computeDistances(int sourceIndex, int* distances) {
+        int n = graph.numVertices;
+        for (int i = 0; i < n; ++i) {
+            distances[i] = INFINITY_DIST;
+            memberStamp[i] = 0;
+        }
+        for (int b = 0; b < numThreads * numBuckets; ++b) buckets[b].clear();
+        for (int t = 0; t < numThreads; ++t) {
+            settledInBucket[t].clear();
+            workerRelaxations[t] = 0;
+        }
+        relaxations = 1;
+        phases = 1;
+        dist = distances;
+        dist[sourceIndex] = 0;
+        buckets[(sourceIndex % numThreads) * numBuckets].push(sourceIndex);
+        current = 0;
+        step = STEP_LIGHT;
+
+        runWorkers(numThreads, workerEntry, this);
+
+        for (int t = 0; t < numThreads; ++t) relaxations += workerRelaxations[t];
+        dist = NULL;
+    }
+
+private:
+    enum Step { STEP_LIGHT, STEP_HEAVY, STEP_DONE };
+
+    // State of the running computeDistances, written only by worker 0 between barriers
+    int* dist;
+    int current; // Absolute bucket number (distance / delta)
+    Step step;
+    ThreadBarrier barrier;
+
+    DeltaSteppingSSSP(const DeltaSteppingSSSP&);
+    DeltaSteppingSSSP& operator=(const DeltaSteppingSSSP&);
+
+    static void workerEntry(void* context, int worker) {
+        ((DeltaSteppingSSSP*)context)->workerLoop(worker);
+    }
+
+    void workerLoop(int t) {
+        while (true) {
+            barrier.wait(); // step and current are settled
+            if (step == STEP_DONE) return;
+            if (step == STEP_LIGHT) generateLight(t);
+            else generateHeavy(t);
+            barrier.wait(); // all requests generated, dist[] is not read any more in this phase
+            applyRequests(t);
+            barrier.wait(); // all requests applied
+            if (t == 0) chooseNextStep();
+        }
+    }
+
+    void generateLight(int t) {
+        // Take this worker's part of the bucket as the frontier; applying light requests may refill it
+        IntList& bucket = buckets[t * numBuckets + current % numBuckets];
+        IntList& frontier = frontiers[t];
+        frontier.clear();
+        for (int i = 0; i < bucket.size; ++i) frontier.push(bucket.data[i]);
+        bucket.clear();
+
+        long long count = 0;
+        for (int i = 0; i < frontier.size; ++i) {
+            int u = frontier.data[i];
+            if (dist[u] / delta != current) continue; // Stale: improved into an earlier slot meanwhile
+            if (memberStamp[u] != current + 1) {
+                memberStamp[u] = current + 1;
+                settledInBucket[t].push(u);
+            }
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                if (graph.edgeWeights[e] <= delta) {
+                    count++;
+                    request(t, graph.edgeTargets[e], dist[u] + graph.edgeWeights[e]);
+                }
+            }
+        }
+        workerRelaxations[t] += count;
+    }
+
+    void generateHeavy(int t) {
+        long long count = 0;
+        IntList& settled = settledInBucket[t];
+        for (int i = 0; i < settled.size; ++i) {
+            int u = settled.data[i];
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                if (graph.edgeWeights[e] > delta) {
+                    count++;
+                    request(t, graph.edgeTargets[e], dist[u] + graph.edgeWeights[e]);
+                }
+            }
+        }
+        settled.clear();
+        workerRelaxations[t] += count;
+    }
+
+    void request(int t, int v, int newDist) {
+        if (newDist >= dist[v]) return; // Read-only here: owners write dist[] only in applyRequests
+        int slot = t * numThreads + v % numThreads;
+        requestTargets[slot].push(v);
+        requestDists[slot].push(newDist);
+    }
+
+    void applyRequests(int t) {
+        for (int from = 0; from < numThreads; ++from) {
+            IntList& targets = requestTargets[from * numThreads + t];
+            IntList& dists = requestDists[from * numThreads + t];
+            for (int i = 0; i < targets.size; ++i) {
+                int v = targets.data[i];
+                if (dists.data[i] >= dist[v]) continue;
+                dist[v] = dists.data[i];
+                buckets[t * numBuckets + (dist[v] / delta) % numBuckets].push(v);
+            }
+            targets.clear();
+            dists.clear();
+        }
+    }
+
+    bool bucketHasEntries(int absoluteBucket) const {
+        int slot = absoluteBucket % numBuckets;
+        for (int t = 0; t < numThreads; ++t) {
+            if (buckets[t * numBuckets + slot].size > 0) return true;
+        }
+        return false;
+    }
+
+    // Light phases repeat until the current bucket stays empty, then one heavy phase, then
+    // on to the next non-empty bucket (heavy edges never land in the current one)
+    void chooseNextStep() {
+        if (step == STEP_LIGHT) {
+            if (bucketHasEntries(current)) phases++;
+            else step = STEP_HEAVY;
+            return;
+        }
+        for (int k = 1; k < numBuckets; ++k) {
+            if (bucketHasEntries(current + k)) {
+                current += k;
+                step = STEP_LIGHT;
+                phases++;
+                return;
+            }
+        }
+        step = STEP_DONE;
+    }
+};
+
+// --- AMBITIOUS FEATURE: Direction-optimizing BFS (Beamer-style) ---
+// Hop distances over dense CSR indices with 64-bit bitmaps instead of string queues. Small
+// frontiers are expanded top-down (each frontier vertex scans its out-edges). Once the
+// frontier is growing and its out-edges outnumber the unexplored edges / ALPHA, it switches to bottom-up:
+// every unvisited vertex scans its in-edges and stops at the first parent found in the
+// frontier bitmap, which skips most edges when the frontier covers a big part of the city.
+// It goes back to top-down when the frontier shrinks below N / BETA.
+// With numThreads > 1, levels whose frontier has at least PARALLEL_MIN_EDGES out-edges are
+// split across workers (smaller ones are not worth starting threads for). A bottom-up level
+// gives each worker a range of bitmap words, so every bit and hops[] entry has one writer.
+// A top-down level gives each worker a slice of the frontier; workers only read the visited
+// bitmap and collect candidate vertices, which are then claimed (and de-duplicated) in order.
+class DirectionOptimizingBFS {
+public:
+    static const int ALPHA = 14;
+    static const int BETA = 24;
+    static const int PARALLEL_MIN_EDGES = 4096;
+
+    const CSRGraph& graph;
+    int numThreads;
+    int words; // 64-bit words per bitmap
+    unsigned long long* visited;
+    unsigned long long* frontierBits;
+    unsigned long long* nextBits;
+    IntList frontier; // Top-down frontier as a list
+    IntList next;
+    int topDownSteps;  // Statistics of the last run
+    int bottomUpSteps;
+    int parallelSteps;
+    long long edgesExamined;
+
+    DirectionOptimizingBFS(const CSRGraph& g, int threads = 1) : graph(g), numThreads(threads < 1 ? 1 : threads), topDownSteps(0), bottomUpSteps(0),
+                                                                  parallelSteps(0), edgesExamined(0), levelHops(NULL), currentLevel(0) {
+        words = (graph.numVertices + 63) / 64;
+        if (words == 0) words = 1;
+        visited = new unsigned long long[words];
+        frontierBits = new unsigned long long[words];
+        nextBits = new unsigned long long[words];
+        candidates = new IntList[numThreads];
+        workerStats = new LevelStats[numThreads];
+    }
+
+    ~DirectionOptimizingBFS() {
+        delete[] visited;
+        delete[] frontierBits;
+        delete[] nextBits;
+        delete[] candidates;
+        delete[] workerStats;
+    }
+
+    // Fills hops[0..N-1] with the number of roads from sourceIndex (-1 = unreachable) and
+    // returns how many vertices were reached. allowBottomUp = false gives plain top-down BFS.
+    int computeHops(int sourceIndex, int* hops, bool allowBottomUp = true) {
+        int n = graph.numVertices;
+        for (int i = 0; i < n; ++i) hops[i] = -1;
+        for (int w = 0; w < words; ++w) visited[w] = 0;
+        topDownSteps = 0;
+        bottomUpSteps = 0;
+        parallelSteps = 0;
+        edgesExamined = 0;
+        if (sourceIndex < 0 || sourceIndex >= n) return 0;
+
+        frontier.clear();
+        frontier.push(sourceIndex);
+        setBit(visited, sourceIndex);
+        hops[sourceIndex] = 0;
+        levelHops = hops;
+        int reached = 1;
+        int frontierSize = 1;
+        int previousSize = 0;
+        long long frontierEdges = graph.outDegree(sourceIndex);
+        long long unexploredEdges = graph.numEdges - frontierEdges;
+        bool bottomUp = false;
+
+        for (int level = 0; frontierSize > 0; ++level) {
+            if (!bottomUp && allowBottomUp && frontierSize > previousSize && frontierEdges > unexploredEdges / ALPHA) {
+                bottomUp = true;
+                for (int w = 0; w < words; ++w) frontierBits[w] = 0;
+                for (int i = 0; i < frontier.size; ++i) setBit(frontierBits, frontier.data[i]);
+            } else if (bottomUp && frontierSize < n / BETA) {
+                bottomUp = false;
+                frontier.clear();
+                for (int v = 0; v < n; ++v) {
+                    if (testBit(frontierBits, v)) frontier.push(v);
+                }
+            }
+
+            currentLevel = level;
+            bool parallel = numThreads > 1 && frontierEdges >= PARALLEL_MIN_EDGES;
+            if (parallel) parallelSteps++;
+            LevelStats stats;
+            if (bottomUp) {
+                bottomUpSteps++;
+                if (parallel) {
+                    runWorkers(numThreads, bottomUpWorker, this);
+                    stats = sumWorkerStats();
+                } else {
+                    bottomUpWords(0, words, stats);
+                }
+                // Mark after the sweep so a vertex found this level is not used as a parent yet
+                for (int w = 0; w < words; ++w) visited[w] |= nextBits[w];
+                unsigned long long* swap = frontierBits;
+                frontierBits = nextBits;
+                nextBits = swap;
+            } else {
+                topDownSteps++;
+                next.clear();
+                if (parallel) {
+                    runWorkers(numThreads, topDownWorker, this);
+                    stats = sumWorkerStats();
+                    for (int t = 0; t < numThreads; ++t) {
+                        for (int i = 0; i < candidates[t].size; ++i) claim(candidates[t].data[i], stats);
+                    }
+                } else {
+                    for (int i = 0; i < frontier.size; ++i) {
+                        int u = frontier.data[i];
+                        for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                            stats.edges++;
+                            claim(graph.edgeTargets[e], stats);
+                        }
+                    }
+                }
+                frontier.clear();
+                for (int i = 0; i < next.size; ++i) frontier.push(next.data[i]);
+            }
+            edgesExamined += stats.edges;
+            reached += stats.nextSize;
+            previousSize = frontierSize;
+            frontierSize = stats.nextSize;
+            frontierEdges = stats.nextEdges;
+            unexploredEdges -= stats.nextEdges;
+        }
+        levelHops = NULL;
+        return reached;
+    }
+
+private:
+    struct LevelStats {
+        long long edges;     // Edges examined
+        int nextSize;        // Vertices discovered
+        long long nextEdges; // Their out-edges
+        LevelStats() : edges(0), nextSize(0), nextEdges(0) {}
+    };
+
+    IntList* candidates;     // Per worker: unvisited targets seen in its slice of a top-down frontier
+    LevelStats* workerStats;
+    int* levelHops;          // Output array and level of the running computeHops, for the workers
+    int currentLevel;
+
+    DirectionOptimizingBFS(const DirectionOptimizingBFS&);
+    DirectionOptimizingBFS& operator=(const DirectionOptimizingBFS&);
+
+    // Top-down discovery of v (a no-op if it is already visited)
+    void claim(int v, LevelStats& stats) {
+        if (testBit(visited, v)) return;
+        setBit(visited, v);
+        levelHops[v] = currentLevel + 1;
+        next.push(v);
+        stats.nextSize++;
+        stats.nextEdges += graph.outDegree(v);
+    }
+
+    // Bottom-up sweep over bitmap words [firstWord, endWord): writes only those words of
+    // nextBits and the hops of their vertices
+    void bottomUpWords(int firstWord, int endWord, LevelStats& stats) {
+        int n = graph.numVertices;
+        for (int w = firstWord; w < endWord; ++w) {
+            nextBits[w] = 0;
+            if (visited[w] == ~0ULL) continue; // Whole word already reached
+            int end = (w + 1) * 64 < n ? (w + 1) * 64 : n;
+            for (int v = w * 64; v < end; ++v) {
+                if (testBit(visited, v)) continue;
+                for (int e = graph.inOffsets[v]; e < graph.inOffsets[v + 1]; ++e) {
+                    stats.edges++;
+                    if (testBit(frontierBits, graph.inSources[e])) {
+                        levelHops[v] = currentLevel + 1;
+                        setBit(nextBits, v);
+                        stats.nextSize++;
+                        stats.nextEdges += graph.outDegree(v);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    static void bottomUpWorker(void* context, int worker) {
+        DirectionOptimizingBFS* bfs = (DirectionOptimizingBFS*)context;
+        LevelStats& stats = bfs->workerStats[worker];
+        stats = LevelStats();
+        bfs->bottomUpWords((long long)bfs->words * worker / bfs->numThreads, (long long)bfs->words * (worker + 1) / bfs->numThreads, stats);
+    }
+
+    static void topDownWorker(void* context, int worker) {
+        DirectionOptimizingBFS* bfs = (DirectionOptimizingBFS*)context;
+        const CSRGraph& graph = bfs->graph;
+        LevelStats& stats = bfs->workerStats[worker];
+        stats = LevelStats();
+        IntList& found = bfs->candidates[worker];
+        found.clear();
+        int first = (long long)bfs->frontier.size * worker / bfs->numThreads;
+        int end = (long long)bfs->frontier.size * (worker + 1) / bfs->numThreads;
+        for (int i = first; i < end; ++i) {
+            int u = bfs->frontier.data[i];
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                stats.edges++;
+                if (!testBit(bfs->visited, graph.edgeTargets[e])) found.push(graph.edgeTargets[e]);
+            }
+        }
+    }
+
+    LevelStats sumWorkerStats() const {
+        LevelStats total;
+        for (int t = 0; t < numThreads; ++t) {
+            total.edges += workerStats[t].edges;
+            total.nextSize += workerStats[t].nextSize;
+            total.nextEdges += workerStats[t].nextEdges;
+        }
+        return total;
+    }
+
+    static void setBit(unsigned long long* bits, int i) {
+        bits[i >> 6] |= 1ULL << (i & 63);
+    }
+
+    static bool testBit(const unsigned long long* bits, int i) {
+        return (bits[i >> 6] >> (i & 63)) & 1ULL;
+    }
+};
+
+// --- AMBITIOUS FEATURE: Dynamic single-source shortest paths (Ramalingam-Reps style) ---
+// Keeps dist/parent for one source in step with Graph::updateEdgeWeight instead of rerunning
+// Dijkstra. A decrease re-settles only the vertices that actually improve, starting at the
+// head of the cheaper road. An increase matters only if the road is a tree edge: the subtree
+// hanging below it is invalidated, each of its vertices is re-seeded from its unaffected
+// in-neighbours (Graph::inListHead) and the subtree is settled again. Every other vertex keeps
+// its distance and is never looked at. touchedLastUpdate reports the size of the repaired region.
+class DynamicShortestPathTree {
+public:
+    Graph& graph;
+    int sourceID;
+    int numVertices;
+    int* dist;   // Indexed by GraphVertexNode::index
+    int* parent; // Dense index of the tree parent, -1 for the source and unreachable vertices
+    int syncedVersion; // graph.version the tree is valid for
+    int touchedLastUpdate;
+    long long totalTouched;
+    int updatesApplied;
+    int fullRecomputes;
+
+    DynamicShortestPathTree(Graph& g, int source) : graph(g), sourceID(source), numVertices(0), dist(NULL), parent(NULL), syncedVersion(-1),
+                                                      touchedLastUpdate(0), totalTouched(0), updatesApplied(0), fullRecomputes(0),
+                                                      heap(NULL), affected(NULL) {
+        recompute();
+    }
+
+    ~DynamicShortestPathTree() {
+        release();
+    }
+
+    int getDistance(int vertexID) {
+        GraphVertexNode* v = graph.findVertex(vertexID);
+        return v && v->index < numVertices ? dist[v->index] : INFINITY_DIST;
+    }
+
+    // Full Dijkstra from the source; also used whenever the graph changed in ways other than
+    // the single weight update being reported (new vertices or roads, missed updates)
+    void recompute() {
+        if (numVertices != graph.numVertices) {
+            release();
+            numVertices = graph.numVertices;
+            int size = numVertices > 0 ? numVertices : 1;
+            dist = new int[size];
+            parent = new int[size];
+            affected = new bool[size];
+            heap = new IndexedDaryHeap(size, 4);
+            for (int i = 0; i < numVertices; ++i) affected[i] = false;
+        }
+        for (int i = 0; i < numVertices; ++i) {
+            dist[i] = INFINITY_DIST;
+            parent[i] = -1;
+        }
+        heap->clear();
+        touchedLastUpdate = 0;
+        GraphVertexNode* start = graph.findVertex(sourceID);
+        if (start) {
+            dist[start->index] = 0;
+            heap->push(start->index, 0);
+            touchedLastUpdate = settle();
+        }
+        syncedVersion = graph.version;
+        fullRecomputes++;
+    }
+
+    // Call after graph.updateEdgeWeight(fromID, toID, newWeight, &oldWeight) succeeded.
+    // Returns the number of vertices whose distance had to be re-examined.
+    int edgeWeightChanged(int fromID, int toID, int oldWeight, int newWeight) {
+        updatesApplied++;
+        if (graph.version != syncedVersion + 1 || graph.numVertices != numVertices) {
+            recompute();
+            totalTouched += touchedLastUpdate;
+            return touchedLastUpdate;
+        }
+        syncedVersion = graph.version;
+        touchedLastUpdate = 0;
+        GraphVertexNode* fromVertex = graph.findVertex(fromID);
+        GraphVertexNode* toVertex = graph.findVertex(toID);
+        if (fromVertex && toVertex && dist[fromVertex->index] != INFINITY_DIST) {
+            int u = fromVertex->index;
+            int v = toVertex->index;
+            if (newWeight < oldWeight) {
+                if (dist[u] + newWeight < dist[v]) {
+                    dist[v] = dist[u] + newWeight;
+                    parent[v] = u;
+                    heap->push(v, dist[v]);
+                    touchedLastUpdate = settle();
+                }
+            } else if (newWeight > oldWeight && parent[v] == u && dist[v] == dist[u] + oldWeight) {
+                touchedLastUpdate = repairSubtree(v);
+            }
+        }
+        totalTouched += touchedLastUpdate;
+        return touchedLastUpdate;
+    }
+
+    // Same layout as Graph::Dijkstra's table (vertex list order, newest first)
+    void printDistances() {
+        cout << "Dijkstra's Shortest Paths from Vertex " << sourceID << ":" << endl;
+        cout << "Vertex distances from " << sourceID << ":" << endl;
+        for (GraphVertexNode* v = graph.vertexListHead; v; v = v->nextVertex) {
+            cout << "  To " << v->id << " (" << v->name << "): ";
+            if (dist[v->index] == INFINITY_DIST) {
+                cout << "Not Reachable" << endl;
+            } else {
+                cout << dist[v->index] << endl;
+            }
+        }
+    }
+
+private:
+    IndexedDaryHeap* heap;
+    bool* affected; // All false between updates
+    IntList affectedList;
+
+    void release() {
+        delete[] dist;
+        delete[] parent;
+        delete[] affected;
+        delete heap;
+        dist = NULL;
+        parent = NULL;
+        affected = NULL;
+        heap = NULL;
+        numVertices = 0;
+    }
+
+    // Dijkstra over whatever is in the heap; returns the number of settled vertices
+    int settle() {
+        int settled = 0;
+        while (!heap->isEmpty()) {
+            int u = heap->pop();
+            settled++;
+            for (GraphEdgeNode* edge = graph.vertexByIndex[u]->adjListHead; edge; edge = edge->next) {
+                int v = graph.findVertex(edge->toVertexID)->index;
+                int newDist = dist[u] + edge->weight;
+                if (newDist < dist[v]) {
+                    dist[v] = newDist;
+                    parent[v] = u;
+                    heap->pushOrDecrease(v, newDist);
+                }
+            }
+        }
+        return settled;
+    }
+
+    int repairSubtree(int root) {
+        // 1. Collect the subtree of root through parent pointers
+        affectedList.clear();
+        affectedList.push(root);
+        affected[root] = true;
+        for (int i = 0; i < affectedList.size; ++i) {
+            int u = affectedList.data[i];
+            for (GraphEdgeNode* edge = graph.vertexByIndex[u]->adjListHead; edge; edge = edge->next) {
+                int v = graph.findVertex(edge->toVertexID)->index;
+                if (!affected[v] && parent[v] == u) {
+                    affected[v] = true;
+                    affectedList.push(v);
+                }
+            }
+        }
+        for (int i = 0; i < affectedList.size; ++i) {
+            dist[affectedList.data[i]] = INFINITY_DIST;
+            parent[affectedList.data[i]] = -1;
+        }
+
+        // 2. Best entry from outside the subtree, whose distances are unchanged
+        for (int i = 0; i < affectedList.size; ++i) {
+            int v = affectedList.data[i];
+            for (GraphEdgeNode* edge = graph.vertexByIndex[v]->inListHead; edge; edge = edge->next) {
+                int u = graph.findVertex(edge->toVertexID)->index;
+                if (affected[u] || dist[u] == INFINITY_DIST) continue;
+                if (dist[u] + edge->weight < dist[v]) {
+                    dist[v] = dist[u] + edge->weight;
+                    parent[v] = u;
+                }
+            }
+            if (dist[v] != INFINITY_DIST) heap->push(v, dist[v]);
+        }
+
+        // 3. Settle the subtree again; only its vertices can improve
+        settle();
+        for (int i = 0; i < affectedList.size; ++i) affected[affectedList.data[i]] = false;
+        return affectedList.size;
+    }
+};
+
+// --- AMBITIOUS FEATURE: K shortest loopless routes (Yen, with Lawler's deviation rule) ---
+// Route i+1 comes from deviating off route i at each of its vertices from the point where
+// route i itself deviated. The prefix up to that spur vertex is kept; roads leaving the spur
+// that accepted routes with the same prefix already take are banned, as are the prefix
+// vertices (so routes stay loopless), and a Dijkstra from the spur to the target completes the
+// candidate. The cheapest candidate becomes the next route. The spur searches of one round
+// only read the accepted routes, so they are spread over numThreads workers; each worker has
+// its own SearchWorkspace and stamped ban arrays, reused for every search it runs. Candidates
+// are added in spur order afterwards, so the routes do not depend on the thread count.
+class KShortestPaths {
+public:
+    const CSRGraph& graph;
+    int numThreads;
+    int spurSearches;       // Statistics of the last find()
+    long long settledTotal;
+
+    KShortestPaths(const CSRGraph& g, int threads = 1) : graph(g), numThreads(threads < 1 ? 1 : threads), spurSearches(0), settledTotal(0),
+                                                          jobPaths(NULL), jobFound(NULL), jobCost(NULL), roundPath(-1), roundTarget(-1), roundWorkers(1) {
+        workers = new SpurWorker*[numThreads];
+        for (int t = 0; t < numThreads; ++t) workers[t] = new SpurWorker(g);
+    }
+
+    ~KShortestPaths() {
+        for (int t = 0; t < numThreads; ++t) delete workers[t];
+        delete[] workers;
+        releaseJobs();
+    }
+
+    // Fills routes[0..k-1] in order of cost and returns how many exist (fewer than k if the
+    // graph has fewer loopless routes). latencyMs[i], if given, receives the wall-clock time
+    // until route i was known, i.e. the latency of a K = i + 1 query.
+    int find(int sourceID, int targetID, int k, RouteResult* routes, double* latencyMs = NULL) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        spurSearches = 0;
+        settledTotal = 0;
+        pathNodes.clear();
+        pathStart.clear();
+        pathLength.clear();
+        pathCost.clear();
+        pathDeviation.clear();
+        pathHash.clear();
+        pathAccepted.clear();
+        accepted.clear();
+        int source = graph.indexOf(sourceID);
+        int target = graph.indexOf(targetID);
+        if (source == -1 || target == -1 || k <= 0) return 0;
+
+        SpurWorker& first = *workers[0];
+        first.nextBanStamp();
+        IntList firstPath;
+        int firstCost = 0;
+        bool reached = spurSearch(first, source, target, firstPath, firstCost);
+        collectStats();
+        if (!reached) return 0;
+        acceptPath(addPath(NULL, 0, 0, 0, firstPath, firstCost), routes, latencyMs, start);
+
+        while (accepted.size < k) {
+            int last = accepted.data[accepted.size - 1];
+            const int* lastNodes = pathNodes.data + pathStart.data[last];
+            int lastLength = pathLength.data[last];
+
+            // One spur search per vertex from the deviation point on, run on the workers
+            jobSpur.clear();
+            jobRootCost.clear();
+            int rootCost = 0;
+            for (int j = 0; j < lastLength - 1; ++j) {
+                if (j >= pathDeviation.data[last]) {
+                    jobSpur.push(j);
+                    jobRootCost.push(rootCost);
+                }
+                rootCost += cheapestEdge(lastNodes[j], lastNodes[j + 1]);
+            }
+            int jobs = jobSpur.size;
+            releaseJobs();
+            jobPaths = new IntList[jobs > 0 ? jobs : 1];
+            jobFound = new bool[jobs > 0 ? jobs : 1];
+            jobCost = new int[jobs > 0 ? jobs : 1];
+            roundPath = last;
+            roundTarget = target;
+            roundWorkers = numThreads < jobs ? numThreads : (jobs > 0 ? jobs : 1);
+            if (jobs > 0) runWorkers(roundWorkers, spurWorkerEntry, this);
+            collectStats();
+
+            for (int i = 0; i < jobs; ++i) {
+                if (!jobFound[i]) continue;
+                lastNodes = pathNodes.data + pathStart.data[last]; // addPath may have grown the pool
+                int candidate = addPath(lastNodes, jobSpur.data[i], jobRootCost.data[i], jobSpur.data[i], jobPaths[i], jobCost[i]);
+                if (isDuplicate(candidate)) discardLastPath();
+            }
+
+            int best = -1;
+            for (int p = 0; p < pathStart.size; ++p) {
+                if (pathAccepted.data[p]) continue;
+                if (best == -1 || pathCost.data[p] < pathCost.data[best] ||
+                    (pathCost.data[p] == pathCost.data[best] && pathLength.data[p] < pathLength.data[best])) {
+                    best = p;
+                }
+            }
+            if (best == -1) break;
+            acceptPath(best, routes, latencyMs, start);
+        }
+        return accepted.size;
+    }
+
+private:
+    // Scratch of one worker: its own workspace and ban stamps
+    struct SpurWorker {
+        SearchWorkspace ws;
+        unsigned int* vertexBan; // == banStamp while banned for the current spur search
+        unsigned int* edgeBan;
+        unsigned int banStamp;
+        int numVertices;
+        int numEdges;
+        int searches;            // Since the last collectStats()
+        long long settled;
+
+        SpurWorker(const CSRGraph& g) : ws(g.numVertices), banStamp(0), numVertices(g.numVertices), numEdges(g.numEdges), searches(0), settled(0) {
+            vertexBan = new unsigned int[numVertices > 0 ? numVertices : 1];
+            edgeBan = new unsigned int[numEdges > 0 ? numEdges : 1];
+            for (int i = 0; i < numVertices; ++i) vertexBan[i] = 0;
+            for (int e = 0; e < numEdges; ++e) edgeBan[e] = 0;
+        }
+
+        ~SpurWorker() {
+            delete[] vertexBan;
+            delete[] edgeBan;
+        }
+
+        void nextBanStamp() {
+            banStamp++;
+            if (banStamp == 0) {
+                for (int i = 0; i < numVertices; ++i) vertexBan[i] = 0;
+                for (int e = 0; e < numEdges; ++e) edgeBan[e] = 0;
+                banStamp = 1;
+            }
+        }
+
+    private:
+        SpurWorker(const SpurWorker&);
+        SpurWorker& operator=(const SpurWorker&);
+    };
+
+    SpurWorker** workers;
+    // Spur searches of the current round: spur index on the last accepted path, cost of the
+    // prefix up to it, and the result of each search
+    IntList jobSpur;
+    IntList jobRootCost;
+    IntList* jobPaths;       // Spur vertex first
+    bool* jobFound;
+    int* jobCost;
+    int roundPath;           // Accepted path the round deviates from
+    int roundTarget;
+    int roundWorkers;
+    // Accepted routes and candidates, stored back to back in pathNodes (dense indices)
+    IntList pathNodes;
+    IntList pathStart;
+    IntList pathLength;
+    IntList pathCost;
+    IntList pathDeviation;   // Index of the spur vertex the path was derived at
+    IntList pathHash;
+    IntList pathAccepted;    // 1 once the path was returned as a route
+    IntList accepted;        // Path ids in the order they were accepted
+
+    KShortestPaths(const KShortestPaths&);
+    KShortestPaths& operator=(const KShortestPaths&);
+
+    void releaseJobs() {
+        delete[] jobPaths;
+        delete[] jobFound;
+        delete[] jobCost;
+        jobPaths = NULL;
+        jobFound = NULL;
+        jobCost = NULL;
+    }
+
+    void collectStats() {
+        for (int t = 0; t < numThreads; ++t) {
+            spurSearches += workers[t]->searches;
+            settledTotal += workers[t]->settled;
+            workers[t]->searches = 0;
+            workers[t]->settled = 0;
+        }
+    }
+
+    // Worker w takes every roundWorkers-th spur of the round; the path pool is read-only meanwhile
+    static void spurWorkerEntry(void* context, int worker) {
+        KShortestPaths& self = *(KShortestPaths*)context;
+        SpurWorker& scratch = *self.workers[worker];
+        const int* lastNodes = self.pathNodes.data + self.pathStart.data[self.roundPath];
+        for (int i = worker; i < self.jobSpur.size; i += self.roundWorkers) {
+            int j = self.jobSpur.data[i];
+            int spur = lastNodes[j];
+            scratch.nextBanStamp();
+            for (int a = 0; a < self.accepted.size; ++a) {
+                int other = self.accepted.data[a];
+                if (self.pathLength.data[other] <= j + 1 || !self.samePrefix(other, self.roundPath, j + 1)) continue;
+                int next = self.pathNodes.data[self.pathStart.data[other] + j + 1];
+                for (int e = self.graph.edgeOffsets[spur]; e < self.graph.edgeOffsets[spur + 1]; ++e) {
+                    if (self.graph.edgeTargets[e] == next) scratch.edgeBan[e] = scratch.banStamp;
+                }
+            }
+            for (int q = 0; q < j; ++q) scratch.vertexBan[lastNodes[q]] = scratch.banStamp;
+            self.jobFound[i] = self.spurSearch(scratch, spur, self.roundTarget, self.jobPaths[i], self.jobCost[i]);
+        }
+    }
+
+    // Dijkstra from 'from' to 'to' avoiding the worker's banned vertices and roads; fills
+    // path (spur vertex first) and cost
+    bool spurSearch(SpurWorker& scratch, int from, int to, IntList& path, int& cost) const {
+        SearchWorkspace& ws = scratch.ws;
+        scratch.searches++;
+        ws.beginSearch();
+        ws.setDist(from, 0, -1);
+        ws.heap.push(from, 0);
+        bool reached = false;
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == to) {
+                reached = true;
+                break;
+            }
+            int du = ws.getDist(u);
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                int v = graph.edgeTargets[e];
+                if (scratch.edgeBan[e] == scratch.banStamp || scratch.vertexBan[v] == scratch.banStamp) continue;
+                int newDist = du + graph.edgeWeights[e];
+                if (newDist < ws.getDist(v)) {
+                    ws.setDist(v, newDist, u);
+                    ws.heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+        scratch.settled += ws.settledCount;
+        if (!reached) return false;
+        cost = ws.getDist(to);
+        path.clear();
+        for (int v = to; v != -1; v = ws.getParent(v)) path.push(v);
+        for (int i = 0, j = path.size - 1; i < j; ++i, --j) { // Parent walk is target first
+            int swap = path.data[i];
+            path.data[i] = path.data[j];
+            path.data[j] = swap;
+        }
+        return true;
+    }
+
+    // Stores rootNodes[0..rootLength) followed by spurPath as a new candidate
+    int addPath(const int* rootNodes, int rootLength, int rootCost, int deviation, const IntList& spurPath, int spurCost) {
+        int* copy = new int[rootLength > 0 ? rootLength : 1]; // rootNodes may point into pathNodes
+        for (int i = 0; i < rootLength; ++i) copy[i] = rootNodes[i];
+        pathStart.push(pathNodes.size);
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < rootLength; ++i) {
+            pathNodes.push(copy[i]);
+            h = (h ^ (unsigned int)copy[i]) * 16777619u;
+        }
+        for (int i = 0; i < spurPath.size; ++i) {
+            pathNodes.push(spurPath.data[i]);
+            h = (h ^ (unsigned int)spurPath.data[i]) * 16777619u;
+        }
+        delete[] copy;
+        pathLength.push(rootLength + spurPath.size);
+        pathCost.push(rootCost + spurCost);
+        pathDeviation.push(deviation);
+        pathHash.push((int)h);
+        pathAccepted.push(0);
+        return pathStart.size - 1;
+    }
+
+    void discardLastPath() {
+        pathNodes.size = pathStart.data[pathStart.size - 1];
+        pathStart.size--;
+        pathLength.size--;
+        pathCost.size--;
+        pathDeviation.size--;
+        pathHash.size--;
+        pathAccepted.size--;
+    }
+
+    bool isDuplicate(int candidate) const {
+        for (int p = 0; p < candidate; ++p) {
+            if (pathHash.data[p] == pathHash.data[candidate] && pathLength.data[p] == pathLength.data[candidate] &&
+                samePrefix(p, candidate, pathLength.data[p])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool samePrefix(int a, int b, int length) const {
+        const int* nodesA = pathNodes.data + pathStart.data[a];
+        const int* nodesB = pathNodes.data + pathStart.data[b];
+        for (int i = 0; i < length; ++i) {
+            if (nodesA[i] != nodesB[i]) return false;
+        }
+        return true;
+    }
+
+    // Dijkstra always takes the cheapest of parallel roads, so prefix costs use it as well
+    int cheapestEdge(int u, int v) const {
+        int best = INFINITY_DIST;
+        for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+            if (graph.edgeTargets[e] == v && graph.edgeWeights[e] < best) best = graph.edgeWeights[e];
+        }
+        return best;
+    }
+
+    void acceptPath(int p, RouteResult* routes, double* latencyMs, chrono::steady_clock::time_point start) {
+        pathAccepted.data[p] = 1;
+        RouteResult& route = routes[accepted.size];
+        route.allocatePath(pathLength.data[p]);
+        for (int i = 0; i < pathLength.data[p]; ++i) route.pathIDs[i] = graph.vertexIDs[pathNodes.data[pathStart.data[p] + i]];
+        route.found = true;
+        route.cost = pathCost.data[p];
+        route.settledCount = (int)settledTotal;
+        if (latencyMs) latencyMs[accepted.size] = elapsedWallMillis(start);
+        accepted.push(p);
+    }
+};
+
+// --- AMBITIOUS FEATURE: Betweenness centrality (Brandes) ---
+// For every source: a Dijkstra that also counts shortest paths (sigma), then a sweep over
+// the settled vertices in reverse order that pushes each vertex's dependency back to its
+// shortest-path predecessors. Predecessors are found again through the reverse CSR
+// (dist[v] + w == dist[u]) instead of being stored as lists. Path counting needs every road
+// weight to be positive: a zero-weight road joins two vertices at the same distance, which
+// the heap may settle in either order, so the head's sigma could be read before the tail's
+// paths reach it (and a zero-weight cycle has no finite count). Such networks are rejected.
+// One instance is one worker: its scratch arrays are reused for every source it is given and
+// it adds into its own accumulator, so worker threads never share writable state and their
+// accumulators are summed in worker order once all of them have joined.
+class BetweennessCentrality {
+public:
+    const CSRGraph& graph;
+    double* accumulator; // Unnormalized score per dense index, for the sources processed so far
+    int sourcesProcessed;
+
+    BetweennessCentrality(const CSRGraph& g) : graph(g), sourcesProcessed(0), heap(g.numVertices > 0 ? g.numVertices : 1, 4) {
+        int size = graph.numVertices > 0 ? graph.numVertices : 1;
+        accumulator = new double[size];
+        dist = new int[size];
+        sigma = new double[size];
+        delta = new double[size];
+        order = new int[size];
+        for (int i = 0; i < graph.numVertices; ++i) {
+            accumulator[i] = 0;
+            dist[i] = INFINITY_DIST;
+        }
+    }
+
+    ~BetweennessCentrality() {
+        delete[] accumulator;
+        delete[] dist;
+        delete[] sigma;
+        delete[] delta;
+        delete[] order;
+    }
+
+    void addSource(int source) {
+        int settled = 0;
+        dist[source] = 0;
+        sigma[source] = 1;
+        heap.push(source, 0);
+        while (!heap.isEmpty()) {
+            int u = heap.pop();
+            order[settled++] = u;
+            delta[u] = 0;
+            for (int e = graph.edgeOffsets[u]; e < graph.edgeOffsets[u + 1]; ++e) {
+                int v = graph.edgeTargets[e];
+                int newDist = dist[u] + graph.edgeWeights[e];
+                if (newDist < dist[v]) {
+                    dist[v] = newDist;
+                    sigma[v] = sigma[u];
+                    heap.pushOrDecrease(v, newDist);
+                } else if (newDist == dist[v]) {
+                    sigma[v] += sigma[u];
+                }
+            }
+        }
+        for (int i = settled - 1; i > 0; --i) {
+            int w = order[i];
+            double share = (1 + delta[w]) / sigma[w];
+            for (int e = graph.inOffsets[w]; e < graph.inOffsets[w + 1]; ++e) {
+                int v = graph.inSources[e];
+                if (dist[v] != INFINITY_DIST && dist[v] + graph.inWeights[e] == dist[w]) delta[v] += sigma[v] * share;
+            }
+            accumulator[w] += delta[w];
+        }
+        for (int i = 0; i < settled; ++i) dist[order[i]] = INFINITY_DIST; // Reset only what was touched
+        sourcesProcessed++;
+    }
+
+    // Exact scores: every vertex as a source, split over 'workers' threads and merged.
+    // Returns false (scores all 0) if some road has weight 0.
+    static bool computeExact(const CSRGraph& graph, double* scores, int workers = 1) {
+        if (!positiveWeights(graph, scores)) return false;
+        int* sources = new int[graph.numVertices > 0 ? graph.numVertices : 1];
+        for (int i = 0; i < graph.numVertices; ++i) sources[i] = i;
+        computeFromSources(graph, sources, graph.numVertices, scores, workers);
+        delete[] sources;
+        return true;
+    }
+
+    // Approximation: 'samples' random sources, scaled by N / samples (unbiased estimate)
+    static bool computeSampled(const CSRGraph& graph, int samples, double* scores, unsigned int seed = 2024, int workers = 1) {
+        if (!positiveWeights(graph, scores)) return false;
+        if (samples > graph.numVertices) samples = graph.numVertices;
+        int* pool = new int[graph.numVertices > 0 ? graph.numVertices : 1];
+        for (int i = 0; i < graph.numVertices; ++i) pool[i] = i;
+        SimpleRandom rng(seed);
+        for (int i = 0; i < samples; ++i) { // Partial Fisher-Yates: distinct sources
+            int j = rng.nextInRange(i, graph.numVertices - 1);
+            int swap = pool[i];
+            pool[i] = pool[j];
+            pool[j] = swap;
+        }
+        computeFromSources(graph, pool, samples, scores, workers);
+        double scale = samples > 0 ? (double)graph.numVertices / samples : 0;
+        for (int i = 0; i < graph.numVertices; ++i) scores[i] *= scale;
+        delete[] pool;
+        return true;
+    }
+
+    // Indices of the k highest scores, best first (partial selection; k is small)
+    static void topVertices(const double* scores, int n, int k, int* out) {
+        for (int i = 0; i < k; ++i) {
+            int best = -1;
+            for (int v = 0; v < n; ++v) {
+                bool taken = false;
+                for (int j = 0; j < i && !taken; ++j) taken = out[j] == v;
+                if (!taken && (best == -1 || scores[v] > scores[best])) best = v;
+            }
+            out[i] = best;
+        }
+    }
+
+private:
+    IndexedDaryHeap heap;
+    int* dist;     // INFINITY_DIST between sources
+    double* sigma; // Number of shortest paths from the current source
+    double* delta; // Dependency of the current source on each vertex
+    int* order;    // Vertices in the order they were settled
+
+    struct SourceBatch {
+        const CSRGraph& graph;
+        const int* sources;
+        int numSources;
+        int numWorkers;
+        BetweennessCentrality** workers; // Created by their own thread, merged after the join
+
+        SourceBatch(const CSRGraph& g, const int* list, int count, int threads)
+            : graph(g), sources(list), numSources(count), numWorkers(threads < 1 ? 1 : threads) {
+            if (numWorkers > numSources && numSources > 0) numWorkers = numSources;
+            workers = new BetweennessCentrality*[numWorkers];
+            for (int w = 0; w < numWorkers; ++w) workers[w] = NULL;
+        }
+
+        ~SourceBatch() {
+            for (int w = 0; w < numWorkers; ++w) delete workers[w];
+            delete[] workers;
+        }
+
+    private:
+        SourceBatch(const SourceBatch&);
+        SourceBatch& operator=(const SourceBatch&);
+    };
+
+    static void sourceWorker(void* context, int worker) {
+        SourceBatch& batch = *(SourceBatch*)context;
+        BetweennessCentrality* self = new BetweennessCentrality(batch.graph);
+        batch.workers[worker] = self;
+        for (int i = worker; i < batch.numSources; i += batch.numWorkers) self->addSource(batch.sources[i]); // Strided split balances load
+    }
+
+    // Zeroes scores; false if some road would break path counting (weight 0)
+    static bool positiveWeights(const CSRGraph& graph, double* scores) {
+        for (int i = 0; i < graph.numVertices; ++i) scores[i] = 0;
+        for (int e = 0; e < graph.numEdges; ++e) {
+            if (graph.edgeWeights[e] <= 0) return false;
+        }
+        return true;
+    }
+
+    static void computeFromSources(const CSRGraph& graph, const int* sources, int numSources, double* scores, int workers) {
+        SourceBatch batch(graph, sources, numSources, workers);
+        runWorkers(batch.numWorkers, sourceWorker, &batch);
+        for (int w = 0; w < batch.numWorkers; ++w) {
+            for (int v = 0; v < graph.numVertices; ++v) scores[v] += batch.workers[w]->accumulator[v];
+        }
+    }
+};
+
+// --- AMBITIOUS FEATURE: Multi-level overlay routing (CRP-style) ---
+// Metric-independent part: recursive inertial bisection (median cut along the principal axis
+// of the coordinates, or along BFS hop distance from a far vertex when coordinates are
+// missing) splits the locations into equal-sized level-1 cells, and each level-(l+1) cell is
+// the union of the 4 level-l cells two bisection steps below it. Metric-dependent part
+// (customization): per cell, the shortest distances between its boundary vertices (ends of
+// roads leaving the cell) inside the cell, computed bottom-up from the roads at level 1 and
+// from the cliques one level down above that. A query expands original roads only inside the
+// source and target level-1 cells; elsewhere it crosses cells through the clique of the
+// highest level that separates them from both. Cells of one level never read each other's
+// cliques, so customize() splits each level's cells across threads, and a road weight change
+// only redoes the cells containing both of its ends. The overlay keeps its own copy of the
+// road weights (by CSR edge), so a weight change is applied to it directly; the CSRGraph it is
+// given only supplies the topology, which stays the same until roads are added or removed.
+
+// Scratch of one overlay search (query, customization or unpacking): the Dijkstra state plus,
+// per reached vertex, 0 if it was reached over a road or else the level of the clique hop.
+// One per thread; the overlay itself is only read by queries.
+class OverlayWorkspace {
+public:
+    SearchWorkspace search;
+    int* hopLevel;
+
+    OverlayWorkspace(int n) : search(n) {
+        hopLevel = new int[n > 0 ? n : 1];
+    }
+
+    ~OverlayWorkspace() {
+        delete[] hopLevel;
+    }
+
+private:
+    OverlayWorkspace(const OverlayWorkspace&);
+    OverlayWorkspace& operator=(const OverlayWorkspace&);
+};
+
+class OverlayGraph {
+public:
+    static const int MAX_LEVELS = 4;
+    int numLevels;
+    int numVertices;
+    int numCells[MAX_LEVELS + 1];          // Per level; index 0 unused
+    int* cellOf[MAX_LEVELS + 1];           // Level -> dense index -> cell
+    int* boundaryOffsets[MAX_LEVELS + 1];  // Level -> cell -> range in boundaryVertices
+    int* boundaryVertices[MAX_LEVELS + 1];
+    int* boundaryPos[MAX_LEVELS + 1];      // Level -> dense index -> position in its cell's boundary list, -1 if interior
+    int* cliqueOffsets[MAX_LEVELS + 1];    // Level -> cell -> start of its row-major b x b matrix
+    int* cliqueWeights[MAX_LEVELS + 1];
+    int* roadWeights;     // By CSR edge: the weights the cliques were customized with
+    int cutEdges;         // Roads between different level-1 cells
+    int cellsCustomized;  // By the most recent customize/customizeEdge call
+
+    OverlayGraph() : numLevels(0), numVertices(0), roadWeights(NULL), cutEdges(0), cellsCustomized(0) {
+        for (int l = 0; l <= MAX_LEVELS; ++l) {
+            numCells[l] = 0;
+            cellOf[l] = boundaryOffsets[l] = boundaryVertices[l] = boundaryPos[l] = cliqueOffsets[l] = cliqueWeights[l] = NULL;
+        }
+    }
+
+    ~OverlayGraph() {
+        release();
+    }
+
+    // Partitions g into level-1 cells of at most maxCellSize locations and 'levels' nested
+    // levels, then customizes every cell with g's current weights
+    void build(const CSRGraph& g, int maxCellSize, int levels, OverlayWorkspace& ws, int threads = 1) {
+        release();
+        if (levels < 1) levels = 1;
+        if (levels > MAX_LEVELS) levels = MAX_LEVELS;
+        if (maxCellSize < 1) maxCellSize = 1;
+        numLevels = levels;
+        numVertices = g.numVertices;
+        int size = numVertices > 0 ? numVertices : 1;
+        roadWeights = new int[g.numEdges > 0 ? g.numEdges : 1];
+
+        int depth = 2 * (levels - 1); // Enough bisection steps for every level to have 4 children
+        while (((numVertices + (1 << depth) - 1) >> depth) > maxCellSize) depth++;
+        int* order = new int[size];
+        int* leaf = new int[size];
+        double* key = new double[size];
+        int* mark = new int[size];
+        int* queue = new int[size];
+        for (int i = 0; i < numVertices; ++i) {
+            order[i] = i;
+            mark[i] = -1;
+        }
+        int markCounter = 0;
+        bisect(g, order, 0, numVertices, depth, 0, leaf, key, mark, queue, markCounter);
+
+        cutEdges = 0;
+        for (int l = 1; l <= numLevels; ++l) {
+            int shift = 2 * (l - 1);
+            numCells[l] = (1 << depth) >> shift;
+            cellOf[l] = new int[size];
+            for (int v = 0; v < numVertices; ++v) cellOf[l][v] = leaf[v] >> shift;
+        }
+        for (int u = 0; u < numVertices; ++u) {
+            for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) {
+                if (cellOf[1][u] != cellOf[1][g.edgeTargets[e]]) cutEdges++;
+            }
+        }
+        for (int l = 1; l <= numLevels; ++l) collectBoundary(g, l);
+        delete[] order;
+        delete[] leaf;
+        delete[] key;
+        delete[] mark;
+        delete[] queue;
+        customize(g, ws, threads);
+    }
+
+    // Full customization with g's current weights: level by level, each level's cells split
+    // over 'threads' workers (worker 0 uses ws, the others their own workspace)
+    void customize(const CSRGraph& g, OverlayWorkspace& ws, int threads = 1) {
+        for (int e = 0; e < g.numEdges; ++e) roadWeights[e] = g.edgeWeights[e];
+        cellsCustomized = 0;
+        CustomizeBatch batch(*this, g, ws, threads);
+        for (int l = 1; l <= numLevels; ++l) {
+            batch.level = l;
+            runWorkers(batch.numWorkers, customizeWorker, &batch);
+            cellsCustomized += numCells[l];
+        }
+    }
+
+    // Road fromIndex -> toIndex of g (the first one, as Graph::updateEdgeWeight picks) now takes
+    // newWeight: redoes only the cells that contain both ends, from the lowest such level up.
+    // Returns the number of cells redone.
+    int customizeEdge(const CSRGraph& g, int fromIndex, int toIndex, int newWeight, OverlayWorkspace& ws) {
+        cellsCustomized = 0;
+        int e = g.edgeOffsets[fromIndex];
+        while (e < g.edgeOffsets[fromIndex + 1] && g.edgeTargets[e] != toIndex) e++;
+        if (e == g.edgeOffsets[fromIndex + 1]) return 0;
+        roadWeights[e] = newWeight;
+        int level = 1;
+        while (level <= numLevels && cellOf[level][fromIndex] != cellOf[level][toIndex]) level++;
+        for (; level <= numLevels; ++level) {
+            customizeCell(g, level, cellOf[level][fromIndex], ws);
+            cellsCustomized++;
+        }
+        return cellsCustomized;
+    }
+
+    int totalCells() const {
+        int total = 0;
+        for (int l = 1; l <= numLevels; ++l) total += numCells[l];
+        return total;
+    }
+
+    long long cliqueBytes() const {
+        long long bytes = 0;
+        for (int l = 1; l <= numLevels; ++l) bytes += (long long)cliqueOffsets[l][numCells[l]] * sizeof(int);
+        return bytes;
+    }
+
+    // g supplies the topology the overlay was built on; weights come from roadWeights
+    RouteResult query(const CSRGraph& g, int sourceID, int targetID, OverlayWorkspace& scratch) const {
+        RouteResult result;
+        int source = g.indexOf(sourceID);
+        int target = g.indexOf(targetID);
+        if (source == -1 || target == -1 || g.numVertices != numVertices) return result;
+
+        SearchWorkspace& ws = scratch.search;
+        ws.beginSearch();
+        ws.setDist(source, 0, -1);
+        scratch.hopLevel[source] = 0;
+        ws.heap.push(source, 0);
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            ws.settledCount++;
+            if (u == target) break;
+            int du = ws.getDist(u);
+            int level = queryLevel(u, source, target);
+            if (level == 0 || boundaryPos[level][u] == -1) {
+                for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) relax(scratch, u, g.edgeTargets[e], du + roadWeights[e], 0);
+                continue;
+            }
+            int cell = cellOf[level][u];
+            if (scratch.hopLevel[u] != level) { // Came out of a clique of this cell: its row cannot improve anything
+                int begin = boundaryOffsets[level][cell];
+                int count = boundaryOffsets[level][cell + 1] - begin;
+                const int* row = cliqueWeights[level] + cliqueOffsets[level][cell] + boundaryPos[level][u] * count;
+                for (int j = 0; j < count; ++j) {
+                    if (row[j] != INFINITY_DIST) relax(scratch, u, boundaryVertices[level][begin + j], du + row[j], level);
+                }
+            }
+            for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) { // Roads leaving the cell
+                int v = g.edgeTargets[e];
+                if (cellOf[level][v] != cell) relax(scratch, u, v, du + roadWeights[e], 0);
+            }
+        }
+        result.settledCount = ws.settledCount;
+        int cost = ws.getDist(target);
+        if (cost == INFINITY_DIST) return result;
+
+        // Overlay path (vertex, level of the hop that reached it), then clique hops unpacked
+        // by a search restricted to their cell
+        IntList hops, hopLevels;
+        for (int v = target; v != -1; v = ws.getParent(v)) {
+            hops.push(v);
+            hopLevels.push(scratch.hopLevel[v]);
+        }
+        IntList path(hops.size * 2);
+        path.push(source);
+        for (int i = hops.size - 2; i >= 0; --i) {
+            if (hopLevels.data[i] == 0) path.push(hops.data[i]);
+            else unpackShortcut(g, hopLevels.data[i], hops.data[i + 1], hops.data[i], scratch, path);
+        }
+        result.allocatePath(path.size);
+        for (int i = 0; i < path.size; ++i) result.pathIDs[i] = g.vertexIDs[path.data[i]];
+        result.found = true;
+        result.cost = cost;
+        return result;
+    }
+
+private:
+    // One customize() level: worker w redoes cells w, w + numWorkers, ...
+    struct CustomizeBatch {
+        OverlayGraph& overlay;
+        const CSRGraph& graph;
+        int level;
+        int numWorkers;
+        OverlayWorkspace** workspaces; // Per worker; [0] is the caller's
+
+        CustomizeBatch(OverlayGraph& o, const CSRGraph& g, OverlayWorkspace& ws, int threads)
+            : overlay(o), graph(g), level(1), numWorkers(threads < 1 ? 1 : threads) {
+            workspaces = new OverlayWorkspace*[numWorkers];
+            workspaces[0] = &ws;
+            for (int w = 1; w < numWorkers; ++w) workspaces[w] = new OverlayWorkspace(g.numVertices);
+        }
+
+        ~CustomizeBatch() {
+            for (int w = 1; w < numWorkers; ++w) delete workspaces[w];
+            delete[] workspaces;
+        }
+
+    private:
+        CustomizeBatch(const CustomizeBatch&);
+        CustomizeBatch& operator=(const CustomizeBatch&);
+    };
+
+    static void customizeWorker(void* context, int worker) {
+        CustomizeBatch& batch = *(CustomizeBatch*)context;
+        for (int c = worker; c < batch.overlay.numCells[batch.level]; c += batch.numWorkers) {
+            batch.overlay.customizeCell(batch.graph, batch.level, c, *batch.workspaces[worker]);
+        }
+    }
+
+    OverlayGraph(const OverlayGraph&);
+    OverlayGraph& operator=(const OverlayGraph&);
+
+    void release() {
+        for (int l = 1; l <= MAX_LEVELS; ++l) {
+            delete[] cellOf[l];
+            delete[] boundaryOffsets[l];
+            delete[] boundaryVertices[l];
+            delete[] boundaryPos[l];
+            delete[] cliqueOffsets[l];
+            delete[] cliqueWeights[l];
+            cellOf[l] = boundaryOffsets[l] = boundaryVertices[l] = boundaryPos[l] = cliqueOffsets[l] = cliqueWeights[l] = NULL;
+            numCells[l] = 0;
+        }
+        delete[] roadWeights;
+        roadWeights = NULL;
+        numLevels = 0;
+    }
+
+    static void relax(OverlayWorkspace& scratch, int u, int v, int newDist, int level) {
+        SearchWorkspace& ws = scratch.search;
+        if (newDist < ws.getDist(v)) {
+            ws.setDist(v, newDist, u);
+            scratch.hopLevel[v] = level;
+            ws.heap.pushOrDecrease(v, newDist);
+        }
+    }
+
+    // Highest level at which v's cell differs from both the source's and the target's (0 = none)
+    int queryLevel(int v, int source, int target) const {
+        for (int l = numLevels; l >= 1; --l) {
+            if (cellOf[l][v] != cellOf[l][source] && cellOf[l][v] != cellOf[l][target]) return l;
+        }
+        return 0;
+    }
+
+    // Splits order[lo, hi) in two equal halves 'remaining' more times; leaves get consecutive codes
+    void bisect(const CSRGraph& g, int* order, int lo, int hi, int remaining, int code, int* leaf, double* key, int* mark, int* queue, int& markCounter) {
+        if (remaining == 0) {
+            for (int i = lo; i < hi; ++i) leaf[order[i]] = code;
+            return;
+        }
+        if (hi - lo > 1) {
+            if (g.hasAllCoordinates) inertialKeys(g, order, lo, hi, key);
+            else hopKeys(g, order, lo, hi, key, mark, queue, markCounter);
+            selectMedian(order, lo, hi, (lo + hi) / 2, key);
+        }
+        int mid = (lo + hi) / 2;
+        bisect(g, order, lo, mid, remaining - 1, code * 2, leaf, key, mark, queue, markCounter);
+        bisect(g, order, mid, hi, remaining - 1, code * 2 + 1, leaf, key, mark, queue, markCounter);
+    }
+
+    // Projection onto the principal axis of the 2x2 coordinate covariance
+    void inertialKeys(const CSRGraph& g, const int* order, int lo, int hi, double* key) const {
+        double meanX = 0, meanY = 0;
+        for (int i = lo; i < hi; ++i) {
+            meanX += g.coordX[order[i]];
+            meanY += g.coordY[order[i]];
+        }
+        meanX /= (hi - lo);
+        meanY /= (hi - lo);
+        double sxx = 0, sxy = 0, syy = 0;
+        for (int i = lo; i < hi; ++i) {
+            double dx = g.coordX[order[i]] - meanX, dy = g.coordY[order[i]] - meanY;
+            sxx += dx * dx;
+            sxy += dx * dy;
+            syy += dy * dy;
+        }
+        double axisX = 1, axisY = 0;
+        if (sxy != 0) {
+            double half = (sxx - syy) / 2;
+            double lambda = (sxx + syy) / 2 + manualSqrt(half * half + sxy * sxy);
+            axisX = sxy;
+            axisY = lambda - sxx;
+        } else if (syy > sxx) {
+            axisX = 0;
+            axisY = 1;
+        }
+        for (int i = lo; i < hi; ++i) key[order[i]] = axisX * g.coordX[order[i]] + axisY * g.coordY[order[i]];
+    }
+
+    // Without coordinates: hop distance (roads in either direction) from a vertex found as
+    // the farthest one from an arbitrary start, restricted to the current part
+    void hopKeys(const CSRGraph& g, const int* order, int lo, int hi, double* key, int* mark, int* queue, int& markCounter) const {
+        int start = order[lo];
+        for (int round = 0; round < 2; ++round) {
+            int member = ++markCounter, seen = ++markCounter;
+            for (int i = lo; i < hi; ++i) {
+                mark[order[i]] = member;
+                key[order[i]] = hi - lo; // Unreached vertices go to the far half
+            }
+            int head = 0, tail = 0, last = start;
+            queue[tail++] = start;
+            mark[start] = seen;
+            key[start] = 0;
+            while (head < tail) {
+                int u = queue[head++];
+                last = u;
+                for (int pass = 0; pass < 2; ++pass) {
+                    const int* offsets = pass == 0 ? g.edgeOffsets : g.inOffsets;
+                    const int* heads = pass == 0 ? g.edgeTargets : g.inSources;
+                    for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                        int v = heads[e];
+                        if (mark[v] != member) continue;
+                        mark[v] = seen;
+                        key[v] = key[u] + 1;
+                        queue[tail++] = v;
+                    }
+                }
+            }
+            start = last;
+        }
+    }
+
+    // Quickselect: afterwards key[order[i]] <= key[order[k]] <= key[order[j]] for lo <= i < k <= j < hi
+    static void selectMedian(int* order, int lo, int hi, int k, const double* key) {
+        int left = lo, right = hi - 1;
+        while (left < right) {
+            double pivot = key[order[(left + right) / 2]];
+            int i = left, j = right;
+            while (i <= j) {
+                while (key[order[i]] < pivot) i++;
+                while (key[order[j]] > pivot) j--;
+                if (i <= j) {
+                    int swap = order[i];
+                    order[i] = order[j];
+                    order[j] = swap;
+                    i++;
+                    j--;
+                }
+            }
+            if (k <= j) right = j;
+            else if (k >= i) left = i;
+            else break;
+        }
+    }
+
+    void collectBoundary(const CSRGraph& g, int level) {
+        int size = numVertices > 0 ? numVertices : 1;
+        const int* cell = cellOf[level];
+        boundaryPos[level] = new int[size];
+        boundaryOffsets[level] = new int[numCells[level] + 1];
+        for (int c = 0; c <= numCells[level]; ++c) boundaryOffsets[level][c] = 0;
+        int total = 0;
+        for (int v = 0; v < numVertices; ++v) {
+            bool boundary = false;
+            for (int e = g.edgeOffsets[v]; e < g.edgeOffsets[v + 1] && !boundary; ++e) boundary = cell[g.edgeTargets[e]] != cell[v];
+            for (int e = g.inOffsets[v]; e < g.inOffsets[v + 1] && !boundary; ++e) boundary = cell[g.inSources[e]] != cell[v];
+            boundaryPos[level][v] = boundary ? boundaryOffsets[level][cell[v] + 1]++ : -1;
+            if (boundary) total++;
+        }
+        for (int c = 0; c < numCells[level]; ++c) boundaryOffsets[level][c + 1] += boundaryOffsets[level][c];
+        boundaryVertices[level] = new int[total > 0 ? total : 1];
+        for (int v = 0; v < numVertices; ++v) {
+            if (boundaryPos[level][v] != -1) boundaryVertices[level][boundaryOffsets[level][cell[v]] + boundaryPos[level][v]] = v;
+        }
+        cliqueOffsets[level] = new int[numCells[level] + 1];
+        cliqueOffsets[level][0] = 0;
+        for (int c = 0; c < numCells[level]; ++c) {
+            int count = boundaryOffsets[level][c + 1] - boundaryOffsets[level][c];
+            cliqueOffsets[level][c + 1] = cliqueOffsets[level][c] + count * count;
+        }
+        cliqueWeights[level] = new int[cliqueOffsets[level][numCells[level]] > 0 ? cliqueOffsets[level][numCells[level]] : 1];
+    }
+
+    // Dijkstra from 'source' confined to a level-'level' cell: level 1 walks the roads, higher
+    // levels walk the level-below cliques plus the roads between level-below cells. Stops
+    // early once 'target' is settled (-1 = settle the whole cell). scratch.hopLevel records
+    // how each vertex was reached, for unpacking.
+    void cellSearch(const CSRGraph& g, int level, int cell, int source, int target, OverlayWorkspace& scratch) const {
+        int lower = level - 1;
+        SearchWorkspace& ws = scratch.search;
+        ws.beginSearch();
+        ws.setDist(source, 0, -1);
+        scratch.hopLevel[source] = 0;
+        ws.heap.push(source, 0);
+        while (!ws.heap.isEmpty()) {
+            int u = ws.heap.pop();
+            if (u == target) break;
+            int du = ws.getDist(u);
+            if (level == 1) {
+                for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) {
+                    int v = g.edgeTargets[e];
+                    if (cellOf[1][v] == cell) relax(scratch, u, v, du + roadWeights[e], 0);
+                }
+                continue;
+            }
+            int lowerCell = cellOf[lower][u];
+            int lowerBegin = boundaryOffsets[lower][lowerCell];
+            int lowerCount = boundaryOffsets[lower][lowerCell + 1] - lowerBegin;
+            const int* row = cliqueWeights[lower] + cliqueOffsets[lower][lowerCell] + boundaryPos[lower][u] * lowerCount;
+            for (int j = 0; j < lowerCount; ++j) {
+                if (row[j] != INFINITY_DIST) relax(scratch, u, boundaryVertices[lower][lowerBegin + j], du + row[j], lower);
+            }
+            for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) {
+                int v = g.edgeTargets[e];
+                if (cellOf[level][v] == cell && cellOf[lower][v] != lowerCell) relax(scratch, u, v, du + roadWeights[e], 0);
+            }
+        }
+    }
+
+    // One confined search per boundary vertex fills the cell's row-major clique; only that
+    // matrix is written, so cells of one level can run on different threads
+    void customizeCell(const CSRGraph& g, int level, int cell, OverlayWorkspace& scratch) {
+        int begin = boundaryOffsets[level][cell];
+        int count = boundaryOffsets[level][cell + 1] - begin;
+        int* matrix = cliqueWeights[level] + cliqueOffsets[level][cell];
+        for (int i = 0; i < count; ++i) {
+            cellSearch(g, level, cell, boundaryVertices[level][begin + i], -1, scratch);
+            for (int j = 0; j < count; ++j) matrix[i * count + j] = scratch.search.getDist(boundaryVertices[level][begin + j]);
+        }
+    }
+
+    // Appends the roads of clique hop from -> to (excluding 'from'): the confined search that
+    // produced the clique entry is repeated, and its own clique hops are unpacked one level down
+    void unpackShortcut(const CSRGraph& g, int level, int from, int to, OverlayWorkspace& scratch, IntList& path) const {
+        cellSearch(g, level, cellOf[level][from], from, to, scratch);
+        IntList hops, hopLevels;
+        for (int v = to; v != from && v != -1; v = scratch.search.getParent(v)) {
+            hops.push(v);
+            hopLevels.push(scratch.hopLevel[v]);
+        }
+        int previous = from;
+        for (int i = hops.size - 1; i >= 0; --i) {
+            if (hopLevels.data[i] == 0) path.push(hops.data[i]);
+            else unpackShortcut(g, hopLevels.data[i], previous, hops.data[i], scratch, path);
+            previous = hops.data[i];
+        }
+    }
+};
+
+// --- AMBITIOUS FEATURE: Minimum spanning forest (Boruvka with a Kruskal finish) ---
+// Roads are treated as undirected and copied once into contiguous from/to/weight arrays
+// (a two-way road appears twice; the copy is dropped as soon as its ends are joined).
+// Boruvka round: one pass over the array finds every component's cheapest edge and contracts
+// it (edges whose ends are already joined are dropped, the rest are rewritten to connect
+// component roots), then all those cheapest edges are added at once.
+// Ties are broken by edge position, so the edges added in one round never form a cycle.
+// Each round at least halves the number of components; once the array has shrunk below
+// kruskalCutoff the remaining edges are radix-sorted and finished with union-find (Kruskal).
+// The per-edge pass is split across threads by contiguous chunks: each worker compacts its
+// own chunk in place and lowers per-component minima with an atomic compare-and-swap on a
+// packed (weight, position) key, then the surviving chunks are copied back together in
+// parallel. Union-find is only written between passes, after every live edge's ends have
+// been made to point straight at their root, so the workers only read it.
+struct SpanningForest {
+    IntList fromIDs; // Chosen roads, as external location IDs
+    IntList toIDs;
+    IntList weights;
+    long long totalCost;
+    int numVertices;   // Locations covered (the whole graph or the region)
+    int components;    // 1 when the region is connected
+    int boruvkaRounds;
+    int kruskalEdges;  // Edges left for the Kruskal finish
+
+    SpanningForest() : totalCost(0), numVertices(0), components(0), boruvkaRounds(0), kruskalEdges(0) {}
+
+private:
+    SpanningForest(const SpanningForest&);
+    SpanningForest& operator=(const SpanningForest&);
+};
+
+class SpanningTreeBuilder {
+public:
+    const CSRGraph& graph;
+    int numEdges;
+    int* edgeFrom;   // Dense indices; after a Boruvka round, the component roots they belong to
+    int* edgeTo;
+    int* edgeWeight;
+    int* edgeOrder;  // Original position, the tie-breaker
+    int* roadFrom;   // By original position: the road's real ends, for reporting
+    int* roadTo;
+    int numRegionVertices;
+
+    // inRegion (by dense index) limits the forest to a subregion; NULL = the whole network
+    SpanningTreeBuilder(const CSRGraph& g, const bool* inRegion = NULL) : graph(g), numEdges(0), numRegionVertices(0) {
+        int size = g.numEdges > 0 ? g.numEdges : 1;
+        edgeFrom = new int[size];
+        edgeTo = new int[size];
+        edgeWeight = new int[size];
+        edgeOrder = new int[size];
+        roadFrom = new int[size];
+        roadTo = new int[size];
+        region = new bool[g.numVertices > 0 ? g.numVertices : 1];
+        for (int u = 0; u < g.numVertices; ++u) {
+            region[u] = !inRegion || inRegion[u];
+            if (region[u]) numRegionVertices++;
+        }
+        for (int u = 0; u < g.numVertices; ++u) {
+            if (!region[u]) continue;
+            for (int e = g.edgeOffsets[u]; e < g.edgeOffsets[u + 1]; ++e) {
+                int v = g.edgeTargets[e];
+                if (v == u || !region[v]) continue;
+                edgeFrom[numEdges] = u;
+                edgeTo[numEdges] = v;
+                edgeWeight[numEdges] = g.edgeWeights[e];
+                edgeOrder[numEdges] = numEdges;
+                roadFrom[numEdges] = u;
+                roadTo[numEdges] = v;
+                numEdges++;
+            }
+        }
+    }
+
+    ~SpanningTreeBuilder() {
+        delete[] edgeFrom;
+        delete[] edgeTo;
+        delete[] edgeWeight;
+        delete[] edgeOrder;
+        delete[] roadFrom;
+        delete[] roadTo;
+        delete[] region;
+    }
+
+    // Boruvka rounds on 'threads' workers, then Kruskal on what is left. The edge arrays are
+    // consumed. The chosen forest does not depend on the thread count.
+    void boruvka(SpanningForest& out, int kruskalCutoff = 4096, int threads = 1) {
+        int* parent = beginForest(out);
+        BoruvkaPass pass(*this, parent, threads);
+        bool merged = true;
+        while (numEdges > kruskalCutoff && merged) {
+            pass.begin();
+            runWorkers(pass.numWorkers, boruvkaScanWorker, &pass);
+            pass.end();
+            runWorkers(pass.numWorkers, boruvkaCopyWorker, &pass);
+            pass.swapBuffers();
+            merged = false;
+            int numRoots = 0;
+            for (int w = 0; w < pass.numWorkers; ++w) {
+                const IntList& roots = pass.roots[w];
+                numRoots += roots.size;
+                for (int r = 0; r < roots.size; ++r) {
+                    unsigned long long key = pass.cheapest[roots.data[r]].load(memory_order_relaxed);
+                    if (joinRoad(parent, (int)(key & 0xFFFFFFFFu), (int)((unsigned int)(key >> 32) ^ 0x80000000u), out)) merged = true;
+                }
+            }
+            // Every live edge ends at one of these roots; point them at their new root so the
+            // next pass can read parent[] without walking or compressing it
+            for (int w = 0; w < pass.numWorkers; ++w) {
+                const IntList& roots = pass.roots[w];
+                for (int r = 0; r < roots.size; ++r) {
+                    parent[roots.data[r]] = CSRGraph::findRoot(parent, roots.data[r]);
+                    pass.cheapest[roots.data[r]].store(NO_EDGE, memory_order_relaxed);
+                }
+            }
+            if (numRoots > 0) out.boruvkaRounds++;
+        }
+        finishKruskal(parent, out);
+        delete[] parent;
+    }
+
+    // Plain Kruskal over the whole array (the baseline the benchmark compares against)
+    void kruskal(SpanningForest& out) {
+        int* parent = beginForest(out);
+        finishKruskal(parent, out);
+        delete[] parent;
+    }
+
+private:
+    bool* region;
+    static const unsigned long long NO_EDGE = ~0ULL;
+
+    SpanningTreeBuilder(const SpanningTreeBuilder&);
+    SpanningTreeBuilder& operator=(const SpanningTreeBuilder&);
+
+    // State of one Boruvka round, shared by the workers. Worker w owns edges [first(w), first(w + 1))
+    // of the current arrays, writes their survivors to the front of its chunk and then to
+    // [offset[w], offset[w] + live[w]) of the spare arrays.
+    struct BoruvkaPass {
+        SpanningTreeBuilder& builder;
+        const int* parent;
+        int numWorkers;
+        int numEdges;                         // At the start of the round
+        atomic<unsigned long long>* cheapest; // Per root: lightest (weight, position) key, NO_EDGE if none
+        IntList* roots;                       // Per worker: roots whose first key it stored
+        int* live;
+        int* offset;
+        int* spareFrom;
+        int* spareTo;
+        int* spareWeight;
+        int* spareOrder;
+
+        BoruvkaPass(SpanningTreeBuilder& b, const int* unionFind, int threads)
+            : builder(b), parent(unionFind), numWorkers(threads < 1 ? 1 : threads), numEdges(0) {
+            int vertices = b.graph.numVertices > 0 ? b.graph.numVertices : 1;
+            cheapest = new atomic<unsigned long long>[vertices];
+            for (int v = 0; v < vertices; ++v) cheapest[v].store(NO_EDGE, memory_order_relaxed);
+            roots = new IntList[numWorkers];
+            live = new int[numWorkers];
+            offset = new int[numWorkers];
+            int size = b.numEdges > 0 ? b.numEdges : 1;
+            spareFrom = new int[size];
+            spareTo = new int[size];
+            spareWeight = new int[size];
+            spareOrder = new int[size];
+        }
+
+        ~BoruvkaPass() {
+            delete[] cheapest;
+            delete[] roots;
+            delete[] live;
+            delete[] offset;
+            delete[] spareFrom;
+            delete[] spareTo;
+            delete[] spareWeight;
+            delete[] spareOrder;
+        }
+
+        int first(int worker) const {
+            return (int)((long long)numEdges * worker / numWorkers);
+        }
+
+        void begin() {
+            numEdges = builder.numEdges;
+            for (int w = 0; w < numWorkers; ++w) roots[w].clear();
+        }
+
+        void end() { // Chunk survivors -> positions in the compacted array
+            int total = 0;
+            for (int w = 0; w < numWorkers; ++w) {
+                offset[w] = total;
+                total += live[w];
+            }
+            builder.numEdges = total;
+        }
+
+        void swapBuffers() {
+            int* swap = builder.edgeFrom; builder.edgeFrom = spareFrom; spareFrom = swap;
+            swap = builder.edgeTo; builder.edgeTo = spareTo; spareTo = swap;
+            swap = builder.edgeWeight; builder.edgeWeight = spareWeight; spareWeight = swap;
+            swap = builder.edgeOrder; builder.edgeOrder = spareOrder; spareOrder = swap;
+        }
+
+        void offer(int root, unsigned long long key, int worker) {
+            unsigned long long seen = cheapest[root].load(memory_order_relaxed);
+            while (key < seen) {
+                if (cheapest[root].compare_exchange_weak(seen, key, memory_order_relaxed)) {
+                    if (seen == NO_EDGE) roots[worker].push(root); // Exactly one worker replaces NO_EDGE
+                    return;
+                }
+            }
+        }
+
+    private:
+        BoruvkaPass(const BoruvkaPass&);
+        BoruvkaPass& operator=(const BoruvkaPass&);
+    };
+
+    static void boruvkaScanWorker(void* context, int worker) {
+        BoruvkaPass& pass = *(BoruvkaPass*)context;
+        SpanningTreeBuilder& b = pass.builder;
+        int begin = pass.first(worker), end = pass.first(worker + 1);
+        int live = begin;
+        for (int i = begin; i < end; ++i) {
+            int a = pass.parent[b.edgeFrom[i]];
+            int c = pass.parent[b.edgeTo[i]];
+            if (a == c) continue; // Already joined: compacted away
+            b.edgeFrom[live] = a;
+            b.edgeTo[live] = c;
+            b.edgeWeight[live] = b.edgeWeight[i];
+            b.edgeOrder[live] = b.edgeOrder[i];
+            unsigned long long key = ((unsigned long long)((unsigned int)b.edgeWeight[live] ^ 0x80000000u) << 32) | (unsigned int)b.edgeOrder[live];
+            pass.offer(a, key, worker);
+            pass.offer(c, key, worker);
+            live++;
+        }
+        pass.live[worker] = live - begin;
+    }
+
+    static void boruvkaCopyWorker(void* context, int worker) {
+        BoruvkaPass& pass = *(BoruvkaPass*)context;
+        SpanningTreeBuilder& b = pass.builder;
+        int from = pass.first(worker);
+        int to = pass.offset[worker];
+        for (int i = 0; i < pass.live[worker]; ++i) {
+            pass.spareFrom[to + i] = b.edgeFrom[from + i];
+            pass.spareTo[to + i] = b.edgeTo[from + i];
+            pass.spareWeight[to + i] = b.edgeWeight[from + i];
+            pass.spareOrder[to + i] = b.edgeOrder[from + i];
+        }
+    }
+
+    bool lighter(int a, int b) const {
+        return edgeWeight[a] < edgeWeight[b] || (edgeWeight[a] == edgeWeight[b] && edgeOrder[a] < edgeOrder[b]);
+    }
+
+    int* beginForest(SpanningForest& out) {
+        int* parent = new int[graph.numVertices > 0 ? graph.numVertices : 1];
+        for (int v = 0; v < graph.numVertices; ++v) parent[v] = v;
+        out.fromIDs.clear();
+        out.toIDs.clear();
+        out.weights.clear();
+        out.totalCost = 0;
+        out.numVertices = numRegionVertices;
+        out.components = numRegionVertices;
+        out.boruvkaRounds = 0;
+        out.kruskalEdges = 0;
+        return parent;
+    }
+
+    bool join(int* parent, int e, SpanningForest& out) {
+        return joinRoad(parent, edgeOrder[e], edgeWeight[e], out);
+    }
+
+    // Adds road 'position' (index into roadFrom/roadTo) unless its ends are already joined
+    bool joinRoad(int* parent, int position, int weight, SpanningForest& out) {
+        int a = CSRGraph::findRoot(parent, roadFrom[position]);
+        int b = CSRGraph::findRoot(parent, roadTo[position]);
+        if (a == b) return false;
+        parent[a] = b;
+        out.fromIDs.push(graph.vertexIDs[roadFrom[position]]);
+        out.toIDs.push(graph.vertexIDs[roadTo[position]]);
+        out.weights.push(weight);
+        out.totalCost += weight;
+        out.components--;
+        return true;
+    }
+
+    // Stable LSD radix sort of the remaining edges by weight (two 16-bit digits, sign bit
+    // flipped so negative weights order correctly), then union-find in that order
+    void finishKruskal(int* parent, SpanningForest& out) {
+        out.kruskalEdges = numEdges;
+        int size = numEdges > 0 ? numEdges : 1;
+        int* order = new int[size];
+        int* scratch = new int[size];
+        int* counts = new int[65536];
+        for (int i = 0; i < numEdges; ++i) order[i] = i;
+        for (int shift = 0; shift < 32; shift += 16) {
+            for (int d = 0; d < 65536; ++d) counts[d] = 0;
+            for (int i = 0; i < numEdges; ++i) counts[digit(order[i], shift)]++;
+            int sum = 0;
+            for (int d = 0; d < 65536; ++d) {
+                int c = counts[d];
+                counts[d] = sum;
+                sum += c;
+            }
+            for (int i = 0; i < numEdges; ++i) scratch[counts[digit(order[i], shift)]++] = order[i];
+            int* swap = order;
+            order = scratch;
+            scratch = swap;
+        }
+        for (int i = 0; i < numEdges && out.components > 1; ++i) join(parent, order[i], out);
+        delete[] order;
+        delete[] scratch;
+        delete[] counts;
+    }
+
+    int digit(int e, int shift) const {
+        return (int)((((unsigned int)edgeWeight[e]) ^ 0x80000000u) >> shift) & 0xFFFF;
+    }
+};
+
+// --- AMBITIOUS FEATURE: Min-cost flow (successive shortest paths with potentials) ---
+// Residual network built from the live Graph: every road with capacity > 0 becomes an arc
+// pair (arc a and its reverse a ^ 1), plus a super source feeding each district with its
+// population and a super sink fed by each shelter up to its capacity. Each phase runs one
+// heap-based Dijkstra on reduced costs (cost + pi[u] - pi[v] >= 0), stopping when the sink is
+// settled, and folds the distances into the potentials. Every path made of zero-reduced-cost
+// arcs is then a cheapest path, so the phase pushes a blocking flow over those arcs (Dinic
+// levels and current-arc pointers) instead of a single path. Road costs must be >= 0.
+struct FlowPhase {
+    double ms;
+    int flow;      // Units pushed in this phase
+    int unitCost;  // Cost of each of those units (the current shortest path length)
+    int paths;     // Augmenting paths found by the blocking flow
+    int settled;   // Nodes settled by the phase's Dijkstra
+};
+
+class MinCostFlow {
+public:
+    int numNodes;     // Graph vertices by dense index, then the super source and super sink
+    int numArcs;
+    int source;
+    int sink;
+    int* arcTail;
+    int* arcHead;
+    int* arcCap;      // Residual capacity
+    int* arcCost;
+    int* arcInitialCap;
+    int numRoadArcs;  // Arcs [0, numRoadArcs) come from roads, in pairs
+    long long totalFlow;
+    long long totalCost;
+    FlowPhase* phases;
+    int numPhases;
+
+    MinCostFlow(Graph& g, const int* districtIDs, const int* populations, int numDistricts, const int* shelterIDs, const int* shelterCaps, int numShelters)
+        : numNodes(g.numVertices + 2), numArcs(0), source(g.numVertices), sink(g.numVertices + 1), totalFlow(0), totalCost(0), numPhases(0), phaseCapacity(16) {
+        int maxArcs = 2 * (g.numEdges + numDistricts + numShelters);
+        if (maxArcs < 1) maxArcs = 1;
+        arcTail = new int[maxArcs];
+        arcHead = new int[maxArcs];
+        arcCap = new int[maxArcs];
+        arcCost = new int[maxArcs];
+        arcInitialCap = new int[maxArcs];
+        for (int u = 0; u < g.numVertices; ++u) {
+            for (GraphEdgeNode* edge = g.vertexByIndex[u]->adjListHead; edge; edge = edge->next) {
+                if (edge->capacity > 0) addArcPair(u, g.findVertex(edge->toVertexID)->index, edge->capacity, edge->weight);
+            }
+        }
+        numRoadArcs = numArcs;
+        for (int i = 0; i < numDistricts; ++i) addArcPair(source, g.findVertex(districtIDs[i])->index, populations[i], 0);
+        for (int i = 0; i < numShelters; ++i) addArcPair(g.findVertex(shelterIDs[i])->index, sink, shelterCaps[i], 0);
+
+        // Arcs grouped by tail (counting sort), so a node's residual arcs are contiguous
+        adjOffsets = new int[numNodes + 1];
+        adjArcs = new int[numArcs > 0 ? numArcs : 1];
+        for (int v = 0; v <= numNodes; ++v) adjOffsets[v] = 0;
+        for (int a = 0; a < numArcs; ++a) adjOffsets[arcTail[a] + 1]++;
+        for (int v = 0; v < numNodes; ++v) adjOffsets[v + 1] += adjOffsets[v];
+        int* fill = new int[numNodes];
+        for (int v = 0; v < numNodes; ++v) fill[v] = adjOffsets[v];
+        for (int a = 0; a < numArcs; ++a) adjArcs[fill[arcTail[a]]++] = a;
+        delete[] fill;
+
+        potential = new int[numNodes];
+        dist = new int[numNodes];
+        settledFlag = new bool[numNodes];
+        level = new int[numNodes];
+        currentArc = new int[numNodes];
+        queue = new int[numNodes];
+        pathArcs = new int[numNodes];
+        for (int v = 0; v < numNodes; ++v) potential[v] = 0;
+        phases = new FlowPhase[phaseCapacity];
+    }
+
+    ~MinCostFlow() {
+        delete[] arcTail;
+        delete[] arcHead;
+        delete[] arcCap;
+        delete[] arcCost;
+        delete[] arcInitialCap;
+        delete[] adjOffsets;
+        delete[] adjArcs;
+        delete[] potential;
+        delete[] dist;
+        delete[] settledFlag;
+        delete[] level;
+        delete[] currentArc;
+        delete[] queue;
+        delete[] pathArcs;
+        delete[] phases;
+    }
+
+    // Sends as much as possible from the districts to the shelters at minimum total cost.
+    // singlePath = true augments one path per Dijkstra (plain SSP, kept for the benchmark).
+    void solve(bool singlePath = false) {
+        IndexedDaryHeap heap(numNodes, 4);
+        while (true) {
+            clock_t start = clock();
+            FlowPhase phase;
+            phase.flow = 0;
+            phase.paths = 0;
+            phase.settled = shortestPaths(heap);
+            if (!settledFlag[sink]) break;
+            int limit = dist[sink];
+            for (int v = 0; v < numNodes; ++v) potential[v] += settledFlag[v] ? dist[v] : limit;
+            phase.unitCost = potential[sink] - potential[source];
+            if (singlePath) {
+                phase.flow = augmentTreePath();
+                phase.paths = 1;
+            } else {
+                blockingFlow(phase);
+            }
+            totalFlow += phase.flow;
+            totalCost += (long long)phase.flow * phase.unitCost;
+            phase.ms = elapsedMillis(start);
+            recordPhase(phase);
+        }
+    }
+
+    int arcFlow(int a) const {
+        return arcInitialCap[a] - arcCap[a];
+    }
+
+private:
+    int* adjOffsets;
+    int* adjArcs;
+    int* potential;
+    int* dist;
+    bool* settledFlag;
+    int* level;
+    int* currentArc;
+    int* queue;
+    int* pathArcs;
+    int phaseCapacity;
+
+    MinCostFlow(const MinCostFlow&);
+    MinCostFlow& operator=(const MinCostFlow&);
+
+    void addArcPair(int u, int v, int capacity, int cost) {
+        arcTail[numArcs] = u; arcHead[numArcs] = v; arcCap[numArcs] = capacity; arcCost[numArcs] = cost; arcInitialCap[numArcs] = capacity;
+        numArcs++;
+        arcTail[numArcs] = v; arcHead[numArcs] = u; arcCap[numArcs] = 0; arcCost[numArcs] = -cost; arcInitialCap[numArcs] = 0;
+        numArcs++;
+    }
+
+    int reducedCost(int a) const {
+        return arcCost[a] + potential[arcTail[a]] - potential[arcHead[a]];
+    }
+
+    // Dijkstra from the source on reduced costs; stops once the sink is settled. dist/
+    // settledFlag are valid for every node afterwards, currentArc holds the tree arcs.
+    int shortestPaths(IndexedDaryHeap& heap) {
+        for (int v = 0; v < numNodes; ++v) {
+            dist[v] = INFINITY_DIST;
+            settledFlag[v] = false;
+            currentArc[v] = -1;
+        }
+        heap.clear();
+        dist[source] = 0;
+        heap.push(source, 0);
+        int settled = 0;
+        while (!heap.isEmpty()) {
+            int u = heap.pop();
+            settledFlag[u] = true;
+            settled++;
+            if (u == sink) break;
+            for (int k = adjOffsets[u]; k < adjOffsets[u + 1]; ++k) {
+                int a = adjArcs[k];
+                if (arcCap[a] == 0) continue;
+                int v = arcHead[a];
+                if (settledFlag[v]) continue;
+                int newDist = dist[u] + reducedCost(a);
+                if (newDist < dist[v]) {
+                    dist[v] = newDist;
+                    currentArc[v] = a;
+                    heap.pushOrDecrease(v, newDist);
+                }
+            }
+        }
+        return settled;
+    }
+
+    // Plain SSP: the one shortest path in the Dijkstra tree
+    int augmentTreePath() {
+        int bottleneck = INFINITY_DIST;
+        for (int v = sink; v != source; v = arcTail[currentArc[v]]) {
+            if (arcCap[currentArc[v]] < bottleneck) bottleneck = arcCap[currentArc[v]];
+        }
+        for (int v = sink; v != source; v = arcTail[currentArc[v]]) {
+            arcCap[currentArc[v]] -= bottleneck;
+            arcCap[currentArc[v] ^ 1] += bottleneck;
+        }
+        return bottleneck;
+    }
+
+    bool admissible(int a) const {
+        return arcCap[a] > 0 && reducedCost(a) == 0;
+    }
+
+    // Dinic on the admissible arcs. Levels are hop counts *to* the sink (BFS backwards over
+    // the reverse of each node's arcs), so only nodes on a cheapest path into the sink get
+    // one; the source side of the shortest-path tree is never scanned. Then repeated
+    // iterative DFS with current-arc pointers until the sink is cut off.
+    void blockingFlow(FlowPhase& phase) {
+        for (int v = 0; v < numNodes; ++v) level[v] = -1;
+        int head = 0, tail = 0;
+        level[sink] = 0;
+        queue[tail++] = sink;
+        while (head < tail && level[source] == -1) {
+            int v = queue[head++];
+            for (int k = adjOffsets[v]; k < adjOffsets[v + 1]; ++k) {
+                int incoming = adjArcs[k] ^ 1; // arcHead[adjArcs[k]] -> v
+                int u = arcTail[incoming];
+                if (level[u] == -1 && admissible(incoming)) {
+                    level[u] = level[v] + 1;
+                    queue[tail++] = u;
+                }
+            }
+        }
+        if (level[source] == -1) return;
+        for (int v = 0; v < numNodes; ++v) currentArc[v] = adjOffsets[v];
+
+        int length = 0, u = source;
+        while (true) {
+            if (u == sink) {
+                int bottleneck = INFINITY_DIST;
+                for (int i = 0; i < length; ++i) {
+                    if (arcCap[pathArcs[i]] < bottleneck) bottleneck = arcCap[pathArcs[i]];
+                }
+                for (int i = 0; i < length; ++i) {
+                    arcCap[pathArcs[i]] -= bottleneck;
+                    arcCap[pathArcs[i] ^ 1] += bottleneck;
+                }
+                phase.flow += bottleneck;
+                phase.paths++;
+                length = 0;
+                u = source;
+                continue;
+            }
+            int k = currentArc[u];
+            while (k < adjOffsets[u + 1] && !(admissible(adjArcs[k]) && level[arcHead[adjArcs[k]]] == level[u] - 1)) k++;
+            currentArc[u] = k;
+            if (k < adjOffsets[u + 1]) {
+                pathArcs[length++] = adjArcs[k];
+                u = arcHead[adjArcs[k]];
+                continue;
+            }
+            if (u == source) break; // Blocked
+            level[u] = -1;          // Dead end: never entered again this phase
+            u = arcTail[pathArcs[--length]];
+        }
+    }
+
+    void recordPhase(const FlowPhase& phase) {
+        if (numPhases == phaseCapacity) {
+            FlowPhase* bigger = new FlowPhase[phaseCapacity * 2];
+            for (int i = 0; i < numPhases; ++i) bigger[i] = phases[i];
+            delete[] phases;
+            phases = bigger;
+            phaseCapacity *= 2;
+        }
+        phases[numPhases++] = phase;
+    }
+};
+
+// --- Route cache: LRU over (source, target, graph version) ---
+// Entries sit in a chained hash table for lookup and in a doubly linked recency list; the
+// least recently used ones are evicted once the estimated memory (entry plus its path)
+// exceeds maxBytes. Entries of older graph versions can never hit again and simply age out.
+struct RouteCacheEntry {
+    int sourceID;
+    int targetID;
+    int version;
+    RouteResult route;
+    RouteCacheEntry* hashNext;
+    RouteCacheEntry* newer;
+    RouteCacheEntry* older;
+
+    RouteCacheEntry(int s, int t, int v, const RouteResult& r) : sourceID(s), targetID(t), version(v), route(r), hashNext(NULL), newer(NULL), older(NULL) {}
+
+    long long bytes() const {
+        return (long long)sizeof(RouteCacheEntry) + (long long)sizeof(int) * route.pathLength;
+    }
+};
+
+class RouteCache {
+public:
+    long long maxBytes;
+    long long usedBytes;
+    int count;
+    long long hits;
+    long long misses;
+    long long evictions;
+
+    RouteCache(long long capBytes = 1024 * 1024) : maxBytes(capBytes), usedBytes(0), count(0), hits(0), misses(0), evictions(0),
+                                                   newest(NULL), oldest(NULL) {
+        allocateBuckets(64);
+    }
+
+    ~RouteCache() {
+        clear();
+        delete[] buckets;
+    }
+
+    // Copies the cached route into 'result' and marks it most recently used
+    bool lookup(int sourceID, int targetID, int version, RouteResult& result) {
+        RouteCacheEntry* entry = buckets[bucketOf(sourceID, targetID, version)];
+        while (entry && (entry->sourceID != sourceID || entry->targetID != targetID || entry->version != version)) entry = entry->hashNext;
+        if (!entry) {
+            misses++;
+            return false;
+        }
+        hits++;
+        unlinkRecency(entry);
+        linkNewest(entry);
+        result = entry->route;
+        return true;
+    }
+
+    void insert(int sourceID, int targetID, int version, const RouteResult& route) {
+        RouteCacheEntry* entry = new RouteCacheEntry(sourceID, targetID, version, route);
+        if (entry->bytes() > maxBytes) { // Would evict everything and still not fit
+            delete entry;
+            return;
+        }
+        if (count >= bucketCount) rehash(bucketCount * 2);
+        int b = bucketOf(sourceID, targetID, version);
+        entry->hashNext = buckets[b];
+        buckets[b] = entry;
+        linkNewest(entry);
+        count++;
+        usedBytes += entry->bytes();
+        while (usedBytes > maxBytes) {
+            evict(oldest);
+            evictions++;
+        }
+    }
+
+    void setMaxBytes(long long capBytes) {
+        maxBytes = capBytes;
+        while (usedBytes > maxBytes && oldest) {
+            evict(oldest);
+            evictions++;
+        }
+    }
+
+    void clear() {
+        while (oldest) evict(oldest);
+    }
+
+    void printStats() const {
+        long long lookups = hits + misses;
+        cout << "Entries: " << count << ", memory: " << usedBytes << " / " << maxBytes << " bytes" << endl;
+        cout << "Hits: " << hits << ", misses: " << misses << ", evictions: " << evictions;
+        if (lookups > 0) cout << ", hit rate: " << (100.0 * hits / lookups) << "%";
+        cout << endl;
+    }
+
+private:
+    RouteCacheEntry** buckets;
+    int bucketCount; // Power of two
+    RouteCacheEntry* newest;
+    RouteCacheEntry* oldest;
+
+    void allocateBuckets(int size) {
+        bucketCount = size;
+        buckets = new RouteCacheEntry*[size];
+        for (int i = 0; i < size; ++i) buckets[i] = NULL;
+    }
+
+    int bucketOf(int sourceID, int targetID, int version) const {
+        unsigned int h = 2166136261u;
+        h = (h ^ (unsigned int)sourceID) * 16777619u;
+        h = (h ^ (unsigned int)targetID) * 16777619u;
+        h = (h ^ (unsigned int)version) * 16777619u;
+        return (int)(h & (unsigned int)(bucketCount - 1));
+    }
+
+    void rehash(int newCount) {
+        RouteCacheEntry** oldBuckets = buckets;
+        int oldCount = bucketCount;
+        allocateBuckets(newCount);
+        for (int i = 0; i < oldCount; ++i) {
+            RouteCacheEntry* entry = oldBuckets[i];
+            while (entry) {
+                RouteCacheEntry* next = entry->hashNext;
+                int b = bucketOf(entry->sourceID, entry->targetID, entry->version);
+                entry->hashNext = buckets[b];
+                buckets[b] = entry;
+                entry = next;
+            }
+        }
+        delete[] oldBuckets;
+    }
+
+    void linkNewest(RouteCacheEntry* entry) {
+        entry->older = newest;
+        entry->newer = NULL;
+        if (newest) newest->newer = entry;
+        newest = entry;
+        if (!oldest) oldest = entry;
+    }
+
+    void unlinkRecency(RouteCacheEntry* entry) {
+        if (entry->newer) entry->newer->older = entry->older;
+        else newest = entry->older;
+        if (entry->older) entry->older->newer = entry->newer;
+        else oldest = entry->newer;
+    }
+
+    void evict(RouteCacheEntry* entry) {
+        RouteCacheEntry** link = &buckets[bucketOf(entry->sourceID, entry->targetID, entry->version)];
+        while (*link != entry) link = &(*link)->hashNext;
+        *link = entry->hashNext;
+        unlinkRecency(entry);
+        usedBytes -= entry->bytes();
+        count--;
+        delete entry;
+    }
+};
+
+// --- Streaming edge-list importer: "from,to,weight[,name]" per line ---
+// The file is read in BUFFER_SIZE chunks; a line cut off at the end of a chunk is moved to
+// the front of the buffer and completed by the next read, so memory stays at one buffer no
+// matter how large the export is (the resulting Graph still has to fit, of course). Fields
+// are parsed in place with a hand-written integer parser; the only strings created are the
+// names of new locations, which are named after the road they first appear on. Empty lines,
+// '#' comments and a non-numeric header line are skipped; malformed lines are counted.
+class EdgeListImporter {
+public:
+    static const int BUFFER_SIZE = 4 * 1024 * 1024;
+    long long bytesRead;  // Statistics of the last import
+    long long lines;
+    long long edgesAdded;
+    int verticesAdded;
+    long long badLines;
+    long long firstBadLine;
+    double elapsedMs;
+
+    EdgeListImporter() : bytesRead(0), lines(0), edgesAdded(0), verticesAdded(0), badLines(0), firstBadLine(0), elapsedMs(0) {
+        buffer = new char[BUFFER_SIZE];
+    }
+
+    ~EdgeListImporter() {
+        delete[] buffer;
+    }
+
+    // Adds the file's roads to 'graph' (existing locations are reused). False if unreadable.
+    bool importFile(const string& filename, Graph& graph) {
+        clock_t start = clock();
+        bytesRead = lines = edgesAdded = badLines = firstBadLine = 0;
+        verticesAdded = 0;
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in) return false;
+
+        // Presize from the file size: a line is ~16 bytes and road networks have ~2 roads per location
+        in.seekg(0, ios::end);
+        long long fileSize = (long long)in.tellg();
+        in.seekg(0, ios::beg);
+        long long estimatedVertices = fileSize / 32;
+        if (estimatedVertices > (1 << 22)) estimatedVertices = 1 << 22; // Beyond that, grow as usual
+        graph.reserveVertices(graph.numVertices + (int)estimatedVertices);
+
+        int carried = 0; // Bytes of an incomplete line kept at the front of the buffer
+        bool skipping = false; // Discarding the rest of an overlong line, up to its newline
+        while (true) {
+            in.read(buffer + carried, BUFFER_SIZE - carried);
+            int got = (int)in.gcount();
+            bytesRead += got;
+            int end = carried + got;
+            bool lastChunk = got == 0 || !in;
+            int lineStart = 0;
+            for (int i = 0; i < end; ++i) {
+                if (buffer[i] != '\n') continue;
+                if (skipping) skipping = false; // Already counted as one bad line
+                else parseLine(buffer + lineStart, buffer + i, graph);
+                lineStart = i + 1;
+            }
+            if (lastChunk) {
+                if (lineStart < end && !skipping) parseLine(buffer + lineStart, buffer + end, graph); // No trailing newline
+                break;
+            }
+            carried = end - lineStart;
+            if (skipping) { // Still inside the overlong line: nothing to keep
+                carried = 0;
+                continue;
+            }
+            if (carried == BUFFER_SIZE) { // A single "line" filling the whole buffer cannot be a road
+                lines++;
+                badLines++;
+                if (firstBadLine == 0) firstBadLine = lines;
+                carried = 0;
+                skipping = true;
+                continue;
+            }
+            for (int i = 0; i < carried; ++i) buffer[i] = buffer[lineStart + i];
+        }
+        elapsedMs = elapsedMillis(start);
+        return true;
+    }
+
+    double megabytesPerSecond() const {
+        return elapsedMs > 0 ? (bytesRead / (1024.0 * 1024.0)) / (elapsedMs / 1000.0) : 0;
+    }
+
+private:
+    char* buffer;
+
+    void parseLine(const char* p, const char* end, Graph& graph) {
+        lines++;
+        if (end > p && end[-1] == '\r') end--; // Windows line endings
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p == end || *p == '#') return;
+        if (lines == 1 && !(*p == '-' || (*p >= '0' && *p <= '9'))) return; // Header row
+
+        int fromID, toID, weight;
+        bool ok = parseInt(p, end, fromID) && expectComma(p, end) &&
+                  parseInt(p, end, toID) && expectComma(p, end) &&
+                  parseInt(p, end, weight) && weight >= 0;
+        const char* nameStart = NULL;
+        const char* nameEnd = NULL;
+        if (ok) {
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            if (p < end) {
+                if (*p != ',') {
+                    ok = false;
+                } else {
+                    nameStart = p + 1;
+                    nameEnd = end;
+                    while (nameStart < nameEnd && (*nameStart == ' ' || *nameStart == '"')) nameStart++;
+                    while (nameEnd > nameStart && (nameEnd[-1] == ' ' || nameEnd[-1] == '"')) nameEnd--;
+                }
+            }
+        }
+        if (!ok) {
+            badLines++;
+            if (firstBadLine == 0) firstBadLine = lines;
+            return;
+        }
+        ensureVertex(graph, fromID, nameStart, nameEnd);
+        ensureVertex(graph, toID, nameStart, nameEnd);
+        graph.addEdge(fromID, toID, weight);
+        edgesAdded++;
+    }
+
+    void ensureVertex(Graph& graph, int id, const char* nameStart, const char* nameEnd) {
+        if (graph.idIndex.find(id) != -1) return;
+        graph.addVertex(id, nameStart && nameEnd > nameStart ? string(nameStart, nameEnd - nameStart) : string("Imported"));
+        verticesAdded++;
+    }
+
+    // Optional spaces, optional '-', digits; rejects empty numbers and int overflow
+    static bool parseInt(const char*& p, const char* end, int& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        bool negative = false;
+        if (p < end && *p == '-') {
+            negative = true;
+            p++;
+        }
+        if (p == end || *p < '0' || *p > '9') return false;
+        long long result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + (*p - '0');
+            if (result > 2147483648LL) return false;
+            p++;
+        }
+        if (negative) result = -result;
+        if (result > 2147483647LL) return false;
+        value = (int)result;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        return true;
+    }
+
+    static bool expectComma(const char*& p, const char* end) {
+        if (p == end || *p != ',') return false;
+        p++;
+        return true;
+    }
+};
+
+
+// --- Versioned routing snapshots (RCU-style publish, reclaimed when the last reader leaves) ---
+// The writer edits the Graph and then publish()es an immutable CSRGraph built from it. A query
+// pin()s whichever snapshot is current when it starts and unpin()s it when done, so it sees
+// one complete version however many edits are published meanwhile, and publishing never
+// waits for readers: the replaced snapshot is retired and freed once no reader holds it.
+// Readers may run on other threads; publish() and reclaim() belong to the one writer thread.
+// A reader announces itself in 'entering' before loading 'current' and leaves only after its
+// pin is counted, so when the writer sees entering == 0 after swapping 'current', every reader
+// that could have loaded a retired snapshot has already made its pin visible, and a retired
+// snapshot whose pin count reads 0 can never be pinned again.
+struct RoadSnapshot {
+    CSRGraph* graph;
+    int graphVersion;     // Graph::version it was built from (negative for road network files)
+    int epoch;            // Publish sequence number
+    atomic<int> pins;     // Readers currently routing on it
+    RoadSnapshot* nextRetired;
+};
+
+class SnapshotRegistry {
+public:
+    atomic<RoadSnapshot*> current;
+    RoadSnapshot* retiredHead; // Retired snapshots not yet freed (writer only)
+    int epoch;
+    int numRetired;
+    int reclaimed;
+
+    SnapshotRegistry() : current(NULL), retiredHead(NULL), epoch(0), numRetired(0), reclaimed(0), entering(0) {}
+
+    ~SnapshotRegistry() { // Readers never outlive the registry
+        while (retiredHead) {
+            RoadSnapshot* next = retiredHead->nextRetired;
+            destroy(retiredHead);
+            retiredHead = next;
+        }
+        RoadSnapshot* last = current.load();
+        if (last) destroy(last);
+    }
+
+    // Takes ownership of 'graph' and makes it the version new readers get
+    RoadSnapshot* publish(CSRGraph* graph, int graphVersion) {
+        RoadSnapshot* next = new RoadSnapshot;
+        next->graph = graph;
+        next->graphVersion = graphVersion;
+        next->epoch = ++epoch;
+        next->pins.store(0, memory_order_relaxed);
+        next->nextRetired = NULL;
+        RoadSnapshot* old = current.exchange(next, memory_order_seq_cst); // Releases the finished snapshot to readers
+        if (old) {
+            old->nextRetired = retiredHead;
+            retiredHead = old;
+            numRetired++;
+        }
+        reclaim();
+        return next;
+    }
+
+    RoadSnapshot* pin() {
+        entering.fetch_add(1, memory_order_seq_cst);
+        RoadSnapshot* snapshot = current.load(memory_order_seq_cst);
+        if (snapshot) snapshot->pins.fetch_add(1, memory_order_relaxed);
+        entering.fetch_sub(1, memory_order_release); // Publishes the pin to reclaim()
+        return snapshot;
+    }
+
+    void unpin(RoadSnapshot* snapshot) {
+        if (snapshot) snapshot->pins.fetch_sub(1, memory_order_release); // The reader's last use happens before the free
+    }
+
+    // Frees the retired snapshots nobody holds; publish() calls it, and the writer may call
+    // it again when readers are done. Returns the number freed.
+    int reclaim() {
+        if (entering.load(memory_order_seq_cst) != 0) return 0; // A reader may still be about to pin one
+        int freed = 0;
+        RoadSnapshot** link = &retiredHead;
+        while (*link) {
+            RoadSnapshot* snapshot = *link;
+            if (snapshot->pins.load(memory_order_acquire) == 0) {
+                *link = snapshot->nextRetired;
+                destroy(snapshot);
+                numRetired--;
+                reclaimed++;
+                freed++;
+            } else {
+                link = &snapshot->nextRetired;
+            }
+        }
+        return freed;
+    }
+
+    void printStats() const {
+        RoadSnapshot* snapshot = current.load();
+        cout << "Current version: " << (snapshot ? snapshot->epoch : 0) << " (graph version " << (snapshot ? snapshot->graphVersion : 0) << ", "
+             << (snapshot ? snapshot->pins.load() : 0) << " readers)" << endl;
+        cout << "Retired but still pinned: " << numRetired << ", reclaimed: " << reclaimed << endl;
+    }
+
+private:
+    atomic<int> entering; // Readers between loading 'current' and counting their pin
+
+    static void destroy(RoadSnapshot* snapshot) {
+        delete snapshot->graph;
+        delete snapshot;
+    }
+
+    SnapshotRegistry(const SnapshotRegistry&);
+    SnapshotRegistry& operator=(const SnapshotRegistry&);
+};
+
+// --- Smart City Entity Definitions ---
+struct Citizen {
+    int id;
+    string name;
+    string address;
+    // Other relevant data, e.g., utility IDs, can be linked via ManualLinkedList if needed
+    Citizen(int i=0, string n="", string addr=""): id(i), name(n), address(addr){}
+};
+
+struct VehicleEntity { // To differentiate from QueueNode for traffic
+    string licensePlate;
+    string type; // CAR, BUS, EMERGENCY_VEHICLE
+    string ownerCitizenName; // Link to citizen
+
+    VehicleEntity(string lp = "", string t = "", string owner = "") : licensePlate(lp), type(t), ownerCitizenName(owner) {}
+};
+
+
+// --- Smart City Module Implementations ---
+class CitizenManagement {
+public:
+    ManualLinkedList citizenList; // Stores Citizen objects (conceptually, NodeLL will hold citizen data)
+    CitizenIndex citizenIndex; // ID -> node in citizenList, O(1) add/find/delete
+    Trie citizenNameTrie; // For quick name search/autocomplete
+
+    CitizenManagement() {}
+
+    void addCitizen(int id, string name, string address) {
+        if (citizenIndex.find(id)) {
+            cout << "Citizen with ID " << id << " already exists." << endl;
+            return;
+        }
+        NodeLL* citizenNode = citizenList.insertAtTail(id, name, address); // Using NodeLL fields for citizen data
+        citizenIndex.insert(id, citizenNode);
+        citizenNameTrie.insert(name);
+        cout << "Citizen " << name << " added." << endl;
+    }
+
+    void findCitizen(int id) {
+        NodeLL* citizenNode = citizenIndex.find(id);
+        if (citizenNode) {
+            cout << "Citizen Found: ID=" << citizenNode->id << ", Name=" << citizenNode->name << ", Address=" << citizenNode->data1 << endl;
+        } else {
+            cout << "Citizen with ID " << id << " not found." << endl;
+        }
+    }
+
+    // The name stays in the Trie: it has no per-name counts and other citizens may share it
+    void deleteCitizen(int id) {
+        NodeLL* citizenNode = citizenIndex.find(id);
+        if (!citizenNode) {
+            cout << "Citizen with ID " << id << " not found." << endl;
+            return;
+        }
+        cout << "Citizen " << citizenNode->name << " removed." << endl;
+        citizenIndex.remove(id);
+        citizenList.removeNode(citizenNode);
+    }
+
+    void displayAllCitizens() {
+        cout << "\n--- All Citizens ---" << endl;
+        citizenList.displayList();
+    }
+
+    void suggestCitizenNames(string prefix) {
+        cout << "\n--- Citizen Name Suggestions for prefix '" << prefix << "' ---" << endl;
+        ManualLinkedList* suggestions = citizenNameTrie.getSuggestions(prefix);
+        if (suggestions->isEmpty()) {
+            cout << "No suggestions found." << endl;
+        } else {
+            suggestions->displayList();
+        }
+        delete suggestions; // Clean up the suggestions list
+    }
+};
+
+class TrafficManagement {
+public:
+    ManualQueue intersectionQueueA; // Example: An intersection with a priority queue
+    // Graph* cityRoadNetwork; // Pointer to the main city graph
+
+    TrafficManagement(/*Graph* roadNetwork*/) {
+        // cityRoadNetwork = roadNetwork;
+    }
+
+    void vehicleArrives(string plate, string type, int priority = 1) { // default priority 1
+        if (type == "EMERGENCY") { // Simple rule for emergency
+            priority = 0;
+        }
+        intersectionQueueA.priorityEnqueue(plate, type, priority);
+        cout << "Vehicle " << plate << " (" << type << ", Prio " << priority <<") arrived at intersection A." << endl;
+    }
+
+    void vehicleDeparts() {
+        if (intersectionQueueA.isEmpty()) {
+            cout << "No vehicles to depart from intersection A." << endl;
+            return;
+        }
+        QueueNode* departed = intersectionQueueA.dequeue();
+        cout << "Vehicle " << departed->licensePlate << " (" << departed->vehicleType << ") departed from intersection A." << endl;
+        delete departed;
+    }
+
+    void displayIntersectionQueue() {
+        cout << "\n--- Intersection A Queue Status ---" << endl;
+        intersectionQueueA.displayQueue();
+    }
+};
+
+class ParkingManagement {
+public:
+    ManualStack parkingLotTower1;
+    int capacity;
+
+    ParkingManagement(int cap = 10) : capacity(cap) {}
+
+    void parkVehicle(string licensePlate) {
+        if (parkingLotTower1.getSize() >= capacity) {
+            cout << "Parking lot Tower 1 is full. Cannot park " << licensePlate << "." << endl;
+            return;
+        }
+        parkingLotTower1.push(licensePlate);
+        cout << "Vehicle " << licensePlate << " parked in Tower 1. Spots left: " << capacity - parkingLotTower1.getSize() << endl;
+    }
+
+    void unparkVehicle() {
+        if (parkingLotTower1.isEmpty()) {
+            cout << "Parking lot Tower 1 is empty. No vehicle to unpark." << endl;
+            return;
+        }
+        string unparkedPlate = parkingLotTower1.pop();
+        cout << "Vehicle " << unparkedPlate << " unparked from Tower 1. Spots left: " << capacity - parkingLotTower1.getSize() << endl;
+    }
+
+    void displayParkingLotStatus() {
+        cout << "\n--- Parking Lot Tower 1 Status (Capacity: " << capacity << ") ---" << endl;
+        parkingLotTower1.displayStack();
+        cout << "Vehicles Parked: " << parkingLotTower1.getSize() << endl;
+        cout << "Spots Available: " << capacity - parkingLotTower1.getSize() << endl;
+    }
+};
+
+
+class UrbanStructure {
+public:
+    NaryTree cityHierarchy;
+
+    UrbanStructure(string cityName) : cityHierarchy(cityName) {}
+
+    void addDepartment(string parentDept, string newDept) {
+        cityHierarchy.addChild(parentDept, newDept);
+        cout << "Department '" << newDept << "' added under '" << parentDept << "'." << endl;
+    }
+
+    void displayCityHierarchy() {
+        cout << "\n--- City Hierarchy ---" << endl;
+        cityHierarchy.displayTree();
+    }
+};
+
+// Point-to-point algorithm used by NetworkService::route
+enum RoutingEngine {
+    ENGINE_DIJKSTRA,
+    ENGINE_ASTAR,
+    ENGINE_BIDIRECTIONAL,
+    ENGINE_CONTRACTION_HIERARCHY,
+    ENGINE_ALT,
+    ENGINE_OVERLAY
+};
+
+class NetworkService {
+public:
+    Graph* cityGraph; // Reference to the main city graph
+    SnapshotRegistry snapshots; // Owns every routing snapshot; readers pin one version at a time
+    CSRGraph* csrSnapshot; // snapshots.current->graph, republished when cityGraph->version changes
+    int csrVersion;
+    SearchWorkspace* workspace; // Sized to csrSnapshot, reused by every route query
+    SearchWorkspace* reverseWorkspace; // Backward half of bidirectional searches
+    RoutingEngine engine;
+    ContractionHierarchy* hierarchy; // Built once per graph version, or loaded from a file
+    int hierarchyVersion;
+    static const int OVERLAY_CELL_SIZE = 64; // Locations per level-1 district cell
+    static const int OVERLAY_LEVELS = 2;
+    OverlayGraph* overlay; // Partition + cliques for ENGINE_OVERLAY; weight changes re-customize it in place
+    OverlayWorkspace* overlayWorkspace; // Scratch of overlay queries, sized to the overlay
+    int overlayVersion;
+    LandmarkIndex landmarkIndex; // ALT tables; refreshed a landmark at a time after changes
+    int landmarkVersion;         // Graph version of the tables currently in use (-1 = none)
+    int landmarkTargetVersion;   // Graph version the running rebuild works on
+    static const int MAX_TRACKED_SOURCES = 8;
+    DynamicShortestPathTree* trackedTrees[MAX_TRACKED_SOURCES]; // Distance tables kept current across road updates, oldest first
+    int numTrackedTrees;
+    RouteCache routeCache; // Answers of route(), keyed by (start, end, graph version)
+    bool routingFromFile;  // csrSnapshot was opened from a road network file and is not rebuilt from cityGraph
+    string routingFileName;
+    int filesOpened;       // Gives every opened file its own (negative) csrVersion
+    int workerThreads;     // Threads used by the parallel engines (hop reachability, ...)
+
+    NetworkService(Graph* graph) : cityGraph(graph), csrSnapshot(NULL), csrVersion(-1), workspace(NULL), reverseWorkspace(NULL), engine(ENGINE_DIJKSTRA),
+                                   hierarchy(NULL), hierarchyVersion(-1), overlay(NULL), overlayWorkspace(NULL), overlayVersion(-1), landmarkIndex(8), landmarkVersion(-1), landmarkTargetVersion(-1), numTrackedTrees(0),
+                                   routingFromFile(false), filesOpened(0), workerThreads(hardwareThreads()) {}
+
+    ~NetworkService() {
+        delete workspace;
+        delete reverseWorkspace;
+        delete hierarchy;
+        delete overlay;
+        delete overlayWorkspace;
+        for (int i = 0; i < numTrackedTrees; ++i) delete trackedTrees[i];
+    }
+
+    // Shortest-path tree of sourceID, created on first use; the oldest one is dropped when full
+    DynamicShortestPathTree* trackedTree(int sourceID) {
+        for (int i = 0; i < numTrackedTrees; ++i) {
+            if (trackedTrees[i]->sourceID == sourceID) {
+                if (trackedTrees[i]->syncedVersion != cityGraph->version) trackedTrees[i]->recompute();
+                return trackedTrees[i];
+            }
+        }
+        if (numTrackedTrees == MAX_TRACKED_SOURCES) {
+            delete trackedTrees[0];
+            for (int i = 1; i < numTrackedTrees; ++i) trackedTrees[i - 1] = trackedTrees[i];
+            numTrackedTrees--;
+        }
+        trackedTrees[numTrackedTrees] = new DynamicShortestPathTree(*cityGraph, sourceID);
+        return trackedTrees[numTrackedTrees++];
+    }
+
+    // Traffic update for one road: every tracked distance table is repaired in place
+    void updateRoadTravelTime(int fromID, int toID, int newWeight) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (newWeight < 0) {
+            cout << "Error: Travel time cannot be negative." << endl;
+            return;
+        }
+        int oldWeight = 0;
+        bool overlayCurrent = overlay && !routingFromFile && overlayVersion == cityGraph->version;
+        if (!cityGraph->updateEdgeWeight(fromID, toID, newWeight, &oldWeight)) {
+            cout << "Error: No road from " << fromID << " to " << toID << "." << endl;
+            return;
+        }
+        cout << "Road " << fromID << " -> " << toID << " travel time changed from " << oldWeight << " to " << newWeight << "." << endl;
+        for (int i = 0; i < numTrackedTrees; ++i) {
+            int touched = trackedTrees[i]->edgeWeightChanged(fromID, toID, oldWeight, newWeight);
+            cout << "  Distances from " << trackedTrees[i]->sourceID << ": " << touched << " of " << cityGraph->numVertices << " locations re-examined." << endl;
+        }
+        if (overlayCurrent) { // Same partition, only the district cells around this road change
+            // The overlay carries its own road weights, so the snapshot it was built on still
+            // serves as its topology; the snapshot itself is rebuilt only when a query needs it
+            clock_t start = clock();
+            int cells = overlay->customizeEdge(*csrSnapshot, csrSnapshot->indexOf(fromID), csrSnapshot->indexOf(toID), newWeight, *overlayWorkspace);
+            overlayVersion = cityGraph->version;
+            cout << "  District overlay: " << cells << " of " << overlay->totalCells() << " cells re-customized in " << elapsedMillis(start) << " ms." << endl;
+        }
+    }
+
+    CSRGraph* getRoutingGraph() {
+        if (routingFromFile) return csrSnapshot;
+        if (!csrSnapshot || csrVersion != cityGraph->version) {
+            delete workspace;
+            delete reverseWorkspace;
+            csrSnapshot = snapshots.publish(new CSRGraph(*cityGraph), cityGraph->version)->graph;
+            workspace = new SearchWorkspace(csrSnapshot->numVertices);
+            reverseWorkspace = new SearchWorkspace(csrSnapshot->numVertices);
+            csrVersion = cityGraph->version;
+        }
+        return csrSnapshot;
+    }
+
+    // Reader side on the service's own thread: publishes pending edits first, and the
+    // snapshot stays valid (and unchanged) until unpinRoutingGraph, whatever edits are
+    // published in between. Reader threads call snapshots.pin()/unpin() directly.
+    RoadSnapshot* pinRoutingGraph() {
+        getRoutingGraph();
+        return snapshots.pin();
+    }
+
+    void unpinRoutingGraph(RoadSnapshot* snapshot) {
+        snapshots.unpin(snapshot);
+        snapshots.reclaim();
+    }
+
+    // One-time preprocessing for ENGINE_CONTRACTION_HIERARCHY, redone only after the graph changes
+    ContractionHierarchy* getHierarchy() {
+        CSRGraph* csr = getRoutingGraph();
+        if (!hierarchy || hierarchyVersion != csrVersion) {
+            delete hierarchy;
+            hierarchy = new ContractionHierarchy();
+            clock_t start = clock();
+            hierarchy->build(*csr);
+            hierarchyVersion = csrVersion;
+            cout << "Contraction hierarchy built in " << elapsedMillis(start) << " ms (" << hierarchy->numShortcuts << " shortcuts)." << endl;
+        }
+        return hierarchy;
+    }
+
+    // Partition and overlay for ENGINE_OVERLAY, rebuilt when roads or locations are added or
+    // removed (travel time changes are applied by updateRoadTravelTime instead)
+    OverlayGraph* getOverlay() {
+        CSRGraph* csr = getRoutingGraph();
+        if (!overlay || overlayVersion != csrVersion) {
+            delete overlay;
+            delete overlayWorkspace;
+            overlay = new OverlayGraph();
+            overlayWorkspace = new OverlayWorkspace(csr->numVertices);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            overlay->build(*csr, OVERLAY_CELL_SIZE, OVERLAY_LEVELS, *overlayWorkspace, workerThreads);
+            overlayVersion = csrVersion;
+            cout << "District overlay built in " << elapsedWallMillis(start) << " ms (" << overlay->numCells[1] << " cells, " << overlay->cutEdges << " roads between cells)." << endl;
+        }
+        return overlay;
+    }
+
+    void saveNetwork(const string& filename) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        clock_t start = clock();
+        if (getRoutingGraph()->saveToFile(filename)) {
+            cout << "Road network saved to '" << filename << "' in " << elapsedMillis(start) << " ms." << endl;
+        } else {
+            cout << "Error: Could not write '" << filename << "'." << endl;
+        }
+    }
+
+    void importEdgeList(const string& filename) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        EdgeListImporter importer;
+        if (!importer.importFile(filename, *cityGraph)) {
+            cout << "Error: Could not read '" << filename << "'." << endl;
+            return;
+        }
+        cout << "Imported " << importer.edgesAdded << " roads and " << importer.verticesAdded << " new locations from "
+             << importer.lines << " lines in " << importer.elapsedMs << " ms (" << importer.megabytesPerSecond() << " MB/s)." << endl;
+        if (importer.badLines > 0) {
+            cout << "Skipped " << importer.badLines << " malformed lines (first at line " << importer.firstBadLine << ")." << endl;
+        }
+    }
+
+    // Routes, tables and traversals then run on the file's network (read-only) instead of
+    // cityGraph; "-" switches back to the live graph
+    void openNetwork(const string& filename) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (filename == "-") {
+            if (routingFromFile) {
+                routingFromFile = false;
+                csrSnapshot = NULL; // Republished from cityGraph below
+                routeCache.clear();
+            }
+            getRoutingGraph();
+            cout << "Routing uses the live city graph again." << endl;
+            return;
+        }
+        CSRGraph* loaded = new CSRGraph();
+        clock_t start = clock();
+        if (!loaded->loadFromFile(filename)) {
+            cout << "Error: '" << filename << "' is missing or not a road network file." << endl;
+            delete loaded;
+            return;
+        }
+        double ms = elapsedMillis(start);
+        delete workspace;
+        delete reverseWorkspace;
+        filesOpened++;
+        csrVersion = -1 - filesOpened; // Never equal to a Graph version, so CH/ALT tables are rebuilt
+        csrSnapshot = snapshots.publish(loaded, csrVersion)->graph;
+        workspace = new SearchWorkspace(csrSnapshot->numVertices);
+        reverseWorkspace = new SearchWorkspace(csrSnapshot->numVertices);
+        routingFromFile = true;
+        routingFileName = filename;
+        routeCache.clear();
+        cout << "Opened '" << filename << "' (" << csrSnapshot->numVertices << " locations, " << csrSnapshot->numEdges << " roads) in " << ms << " ms." << endl;
+        cout << "Routing now uses this file; edits to the city graph do not affect it until you switch back." << endl;
+    }
+
+    void saveHierarchy(const string& filename) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (getHierarchy()->saveToFile(filename)) {
+            cout << "Contraction hierarchy saved to '" << filename << "'." << endl;
+        } else {
+            cout << "Error: Could not write '" << filename << "'." << endl;
+        }
+    }
+
+    void loadHierarchy(const string& filename) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        ContractionHierarchy* loaded = new ContractionHierarchy();
+        if (!loaded->loadFromFile(filename)) {
+            cout << "Error: '" << filename << "' is missing or not a contraction hierarchy file." << endl;
+            delete loaded;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        if (loaded->sourceFingerprint != csr->fingerprint()) {
+            cout << "Error: '" << filename << "' was built for a different road network." << endl;
+            delete loaded;
+            return;
+        }
+        delete hierarchy;
+        hierarchy = loaded;
+        hierarchyVersion = csrVersion;
+        cout << "Contraction hierarchy loaded from '" << filename << "'." << endl;
+    }
+
+    // Many-to-many travel costs in one call. Uses the contraction hierarchy buckets when a
+    // hierarchy for the current graph exists (or CH is the selected engine), otherwise one
+    // early-stopping Dijkstra per source sharing the service's workspace.
+    DistanceMatrix distanceMatrix(const int* sourceIDs, int numSources, const int* targetIDs, int numTargets) {
+        if (!cityGraph) return DistanceMatrix();
+        CSRGraph* csr = getRoutingGraph();
+        if (engine == ENGINE_CONTRACTION_HIERARCHY || (hierarchy && hierarchyVersion == csrVersion)) {
+            return getHierarchy()->distanceMatrix(sourceIDs, numSources, targetIDs, numTargets, *workspace);
+        }
+        return csr->distanceMatrix(sourceIDs, numSources, targetIDs, numTargets, *workspace);
+    }
+
+    void printDistanceMatrix(const int* sourceIDs, int numSources, const int* targetIDs, int numTargets) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        DistanceMatrix matrix = distanceMatrix(sourceIDs, numSources, targetIDs, numTargets);
+        cout << "\n--- Distance Matrix (rows = from, columns = to) ---" << endl;
+        cout << "From\\To";
+        for (int j = 0; j < numTargets; ++j) cout << "\t" << targetIDs[j];
+        cout << endl;
+        for (int i = 0; i < numSources; ++i) {
+            cout << sourceIDs[i];
+            for (int j = 0; j < numTargets; ++j) {
+                if (matrix.get(i, j) == INFINITY_DIST) cout << "\t-";
+                else cout << "\t" << matrix.get(i, j);
+            }
+            cout << endl;
+        }
+    }
+
+    // Background-style maintenance of the ALT tables: each call computes at most 'steps'
+    // landmarks for the current graph version. Returns true when the tables are up to date.
+    // Each step is two full-graph Dijkstras, so it runs from runIdleMaintenance, never from a query.
+    bool maintainLandmarks(int steps = 1) {
+        CSRGraph* csr = getRoutingGraph();
+        if (landmarkVersion == csrVersion) return true;
+        if (!landmarkIndex.isRebuilding() || landmarkTargetVersion != csrVersion) {
+            landmarkIndex.beginRebuild(*csr);
+            landmarkTargetVersion = csrVersion;
+        }
+        for (int i = 0; i < steps && landmarkIndex.isRebuilding(); ++i) {
+            landmarkIndex.rebuildStep();
+        }
+        if (!landmarkIndex.isRebuilding()) landmarkVersion = csrVersion;
+        return landmarkVersion == csrVersion;
+    }
+
+    // Called by the simulator between commands (while it waits for input): advances the ALT
+    // rebuild by one landmark when that engine is selected or its tables are in use
+    void runIdleMaintenance() {
+        if (!cityGraph) return;
+        if (engine == ENGINE_ALT || landmarkVersion != -1) maintainLandmarks(1);
+    }
+
+    void setWorkerThreads(int threads) {
+        workerThreads = threads < 1 ? 1 : threads;
+        cout << "Parallel engines will use " << workerThreads << " thread(s) (" << hardwareThreads() << " available)." << endl;
+    }
+
+    void setEngine(RoutingEngine newEngine) {
+        engine = newEngine;
+        cout << "Routing engine set to " << engineName() << "." << endl;
+    }
+
+    string engineName() const {
+        switch (engine) {
+            case ENGINE_ASTAR: return "A*";
+            case ENGINE_BIDIRECTIONAL: return "Bidirectional Dijkstra";
+            case ENGINE_CONTRACTION_HIERARCHY: return "Contraction Hierarchies";
+            case ENGINE_ALT: return "ALT (landmarks)";
+            case ENGINE_OVERLAY: return "District Overlay (CRP)";
+            default: return "Dijkstra";
+        }
+    }
+
+    // Point-to-point query with the selected engine, returned as a value for callers such as
+    // dispatch. Repeated questions for the same graph version are answered from routeCache.
+    RouteResult route(int startID, int endID) {
+        if (!cityGraph) return RouteResult();
+        RouteResult result;
+        if (routeCache.lookup(startID, endID, cityGraph->version, result)) return result;
+        result = computeRoute(startID, endID);
+        routeCache.insert(startID, endID, cityGraph->version, result);
+        return result;
+    }
+
+    RouteResult computeRoute(int startID, int endID) {
+        CSRGraph* csr = getRoutingGraph();
+        switch (engine) {
+            case ENGINE_ASTAR:
+                return csr->aStarPath(startID, endID, *workspace);
+            case ENGINE_BIDIRECTIONAL:
+                return csr->bidirectionalPath(startID, endID, *workspace, *reverseWorkspace);
+            case ENGINE_CONTRACTION_HIERARCHY:
+                return getHierarchy()->query(startID, endID, *workspace, *reverseWorkspace);
+            case ENGINE_ALT:
+                // Tables built for an older graph could overestimate after a weight decrease, so
+                // answer with plain Dijkstra until runIdleMaintenance has finished the refresh
+                if (landmarkVersion == csrVersion) return landmarkIndex.query(*csr, startID, endID, *workspace);
+                return csr->shortestPath(startID, endID, *workspace);
+            case ENGINE_OVERLAY:
+                return getOverlay()->query(*csr, startID, endID, *overlayWorkspace);
+            default:
+                return csr->shortestPath(startID, endID, *workspace);
+        }
+    }
+
+    void printRoute(const RouteResult& result) {
+        if (!result.found) {
+            cout << "No route found." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        cout << "Route: ";
+        for (int i = 0; i < result.pathLength; ++i) {
+            if (i > 0) cout << " -> ";
+            cout << result.pathIDs[i] << " (" << csr->vertexName(csr->indexOf(result.pathIDs[i])) << ")";
+        }
+        cout << endl;
+        cout << "Total cost: " << result.cost << ", vertices settled: " << result.settledCount << endl;
+    }
+
+    void findShortestPath(int startID, int endID) { // endID == -1 prints the full distance table
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (endID == -1) {
+            cout << "\n--- Finding Shortest Paths (Dijkstra) ---" << endl;
+            if (routingFromFile || !cityGraph->findVertex(startID)) {
+                getRoutingGraph()->Dijkstra(startID); // Also reports a missing vertex
+                return;
+            }
+            trackedTree(startID)->printDistances();
+            return;
+        }
+        cout << "\n--- Finding Route " << startID << " -> " << endID << " (" << engineName() << ") ---" << endl;
+        if (engine == ENGINE_ASTAR && !getRoutingGraph()->hasAllCoordinates) {
+            cout << "Note: not every location has coordinates, A* falls back to plain Dijkstra." << endl;
+        }
+        long long hitsBefore = routeCache.hits;
+        printRoute(route(startID, endID));
+        if (routeCache.hits > hitsBefore) cout << "(answered from the route cache)" << endl;
+    }
+
+    // Rush-hour aware route: departure is minutes after midnight
+    void findTimeDependentRoute(int startID, int endID, int departure) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        cout << "\n--- Finding Route " << startID << " -> " << endID << " departing " << formatClock(departure) << " ---" << endl;
+        RouteResult result = csr->timeDependentPath(startID, endID, departure, *workspace, csr->hasAllCoordinates);
+        printRoute(result);
+        if (result.found) cout << "Arrival: " << formatClock(departure + result.cost) << endl;
+    }
+
+    static string formatClock(int minutes) {
+        int t = minutes % MINUTES_PER_DAY;
+        if (t < 0) t += MINUTES_PER_DAY;
+        string hh = to_string(t / 60), mm = to_string(t % 60);
+        return (hh.size() < 2 ? "0" + hh : hh) + ":" + (mm.size() < 2 ? "0" + mm : mm);
+    }
+
+    void performBFS(int startID) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        cout << "\n--- Performing BFS ---" << endl;
+        getRoutingGraph()->BFS(startID);
+    }
+    
+    // Up to k loopless routes in order of cost, for spreading traffic over alternatives
+    void alternativeRoutes(int startID, int endID, int k) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (k <= 0) {
+            cout << "Number of routes must be positive." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        KShortestPaths engine(*csr, workerThreads);
+        RouteResult* routes = new RouteResult[k];
+        double* latencyMs = new double[k];
+        int found = engine.find(startID, endID, k, routes, latencyMs);
+        cout << "\n--- " << k << " Shortest Routes " << startID << " -> " << endID << " ---" << endl;
+        if (found == 0) cout << "No route found." << endl;
+        for (int i = 0; i < found; ++i) {
+            cout << "#" << (i + 1) << " (after " << latencyMs[i] << " ms) ";
+            printRoute(routes[i]);
+        }
+        if (found > 0 && found < k) cout << "Only " << found << " loopless routes exist." << endl;
+        delete[] routes;
+        delete[] latencyMs;
+    }
+
+    // Every location reachable from stationID within 'budget' minutes
+    void reachableWithin(int stationID, int budget) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        if (csr->indexOf(stationID) == -1) {
+            cout << "Error: Location " << stationID << " not found." << endl;
+            return;
+        }
+        IsochroneSet result;
+        csr->isochrone(stationID, budget, *workspace, result);
+        cout << "\n--- Reachable from " << stationID << " within " << budget << " ---" << endl;
+        for (int k = 0; k < result.setSize(0); ++k) {
+            int id = result.vertexIDs.data[k];
+            cout << "  " << id << " (" << csr->vertexName(csr->indexOf(id)) << "): " << result.costs.data[k] << endl;
+        }
+        cout << result.setSize(0) << " of " << csr->numVertices << " locations." << endl;
+    }
+
+    // Evacuation drill: people from each district to the shelters, respecting road capacities,
+    // with the smallest total travel time (person-minutes). Always plans on the live city graph.
+    void planEvacuation(const int* districtIDs, const int* populations, int numDistricts, const int* shelterIDs, const int* shelterCaps, int numShelters) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        for (int i = 0; i < numDistricts + numShelters; ++i) {
+            int id = i < numDistricts ? districtIDs[i] : shelterIDs[i - numDistricts];
+            int amount = i < numDistricts ? populations[i] : shelterCaps[i - numDistricts];
+            if (!cityGraph->findVertex(id)) {
+                cout << "Error: Location " << id << " not found." << endl;
+                return;
+            }
+            if (amount < 0) {
+                cout << "Error: Population and shelter capacity cannot be negative." << endl;
+                return;
+            }
+        }
+        long long demand = 0;
+        for (int i = 0; i < numDistricts; ++i) demand += populations[i];
+        MinCostFlow flow(*cityGraph, districtIDs, populations, numDistricts, shelterIDs, shelterCaps, numShelters);
+        clock_t start = clock();
+        flow.solve();
+        double ms = elapsedMillis(start);
+
+        cout << "\n--- Evacuation Plan ---" << endl;
+        cout << "Evacuated " << flow.totalFlow << " of " << demand << " people, total travel " << flow.totalCost << " person-minutes." << endl;
+        for (int i = 0; i < numShelters; ++i) {
+            int arc = flow.numRoadArcs + 2 * (numDistricts + i);
+            cout << "  Shelter " << shelterIDs[i] << " (" << cityGraph->findVertex(shelterIDs[i])->name << "): " << flow.arcFlow(arc) << " / " << shelterCaps[i] << endl;
+        }
+        const int MAX_LISTED = 20;
+        int used = 0;
+        cout << "Roads used:" << endl;
+        for (int a = 0; a < flow.numRoadArcs; a += 2) {
+            if (flow.arcFlow(a) == 0) continue;
+            if (used++ < MAX_LISTED) {
+                cout << "  " << cityGraph->vertexByIndex[flow.arcTail[a]]->id << " -> " << cityGraph->vertexByIndex[flow.arcHead[a]]->id << ": " << flow.arcFlow(a)
+                     << " / " << flow.arcInitialCap[a] << (flow.arcCap[a] == 0 ? " (full)" : "") << endl;
+            }
+        }
+        if (used > MAX_LISTED) cout << "  ... and " << (used - MAX_LISTED) << " more roads" << endl;
+        if (flow.totalFlow < demand) cout << "Road or shelter capacity is exhausted: " << (demand - flow.totalFlow) << " people cannot be moved." << endl;
+        cout << flow.numPhases << " phases in " << ms << " ms:" << endl;
+        for (int i = 0; i < flow.numPhases && i < MAX_LISTED; ++i) {
+            const FlowPhase& phase = flow.phases[i];
+            cout << "  Phase " << (i + 1) << ": " << phase.ms << " ms, " << phase.flow << " people at " << phase.unitCost << " minutes each, "
+                 << phase.paths << " paths, " << phase.settled << " settled" << endl;
+        }
+    }
+
+    // Cheapest set of road segments connecting every location (fiber / water main layout).
+    // centerID 0 plans the whole city, otherwise the locations within 'budget' of centerID.
+    void planUtilityNetwork(int centerID, int budget) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        bool* inRegion = NULL;
+        if (centerID != 0) {
+            if (csr->indexOf(centerID) == -1) {
+                cout << "Error: Location " << centerID << " not found." << endl;
+                return;
+            }
+            IsochroneSet area;
+            csr->isochrone(centerID, budget, *workspace, area);
+            inRegion = new bool[csr->numVertices];
+            for (int v = 0; v < csr->numVertices; ++v) inRegion[v] = false;
+            for (int k = 0; k < area.setSize(0); ++k) inRegion[csr->indexOf(area.vertexIDs.data[k])] = true;
+        }
+        SpanningForest forest;
+        clock_t start = clock();
+        SpanningTreeBuilder builder(*csr, inRegion);
+        builder.boruvka(forest, 4096, workerThreads);
+        double ms = elapsedMillis(start);
+        delete[] inRegion;
+
+        const int MAX_LISTED = 20;
+        cout << "\n--- Utility Network Plan (" << forest.numVertices << " locations) ---" << endl;
+        for (int i = 0; i < forest.fromIDs.size && i < MAX_LISTED; ++i) {
+            int from = forest.fromIDs.data[i], to = forest.toIDs.data[i];
+            cout << "  " << from << " (" << csr->vertexName(csr->indexOf(from)) << ") - " << to << " (" << csr->vertexName(csr->indexOf(to)) << "): " << forest.weights.data[i] << endl;
+        }
+        if (forest.fromIDs.size > MAX_LISTED) cout << "  ... and " << (forest.fromIDs.size - MAX_LISTED) << " more segments" << endl;
+        cout << "Segments: " << forest.fromIDs.size << ", total cost: " << forest.totalCost << " (" << ms << " ms)" << endl;
+        if (forest.components > 1) cout << "Not connected by roads: " << forest.components << " separate networks are needed." << endl;
+    }
+
+    // Locations ranked by betweenness: how many shortest routes pass through them.
+    // samples <= 0 runs the exact computation, otherwise that many random sources.
+    void rankCriticalIntersections(int topK, int samples) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        if (csr->numVertices == 0) {
+            cout << "The network has no locations." << endl;
+            return;
+        }
+        double* scores = new double[csr->numVertices];
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        bool ok;
+        if (samples <= 0 || samples >= csr->numVertices) ok = BetweennessCentrality::computeExact(*csr, scores, workerThreads);
+        else ok = BetweennessCentrality::computeSampled(*csr, samples, scores, 2024, workerThreads);
+        double ms = elapsedWallMillis(start);
+        if (!ok) {
+            cout << "Error: Critical intersections need every travel time to be positive (found a road with travel time 0)." << endl;
+            delete[] scores;
+            return;
+        }
+        int* ranking = new int[csr->numVertices];
+        if (topK > csr->numVertices) topK = csr->numVertices;
+        BetweennessCentrality::topVertices(scores, csr->numVertices, topK, ranking);
+        cout << "\n--- Critical Intersections (" << (samples <= 0 || samples >= csr->numVertices ? "exact" : "sampled") << ", " << ms << " ms) ---" << endl;
+        for (int i = 0; i < topK; ++i) {
+            int v = ranking[i];
+            cout << (i + 1) << ". " << csr->vertexIDs[v] << " (" << csr->vertexName(v) << "): " << scores[v] << endl;
+        }
+        delete[] ranking;
+        delete[] scores;
+    }
+
+    void closeRoad(int fromID, int toID) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        if (cityGraph->removeEdge(fromID, toID)) {
+            cout << "Road " << fromID << " -> " << toID << " closed." << endl;
+        } else {
+            cout << "Error: No road from " << fromID << " to " << toID << "." << endl;
+        }
+    }
+
+    // Islands after closures: weakly connected components other than the largest are cut off
+    // completely; vertices outside the largest strongly connected component can still be
+    // reached or left, but not both (one-way traps)
+    void connectivityReport() {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        int n = csr->numVertices;
+        cout << "\n--- Road Network Connectivity ---" << endl;
+        if (n == 0) {
+            cout << "Graph is empty." << endl;
+            return;
+        }
+        int* weak = new int[n];
+        int* strong = new int[n];
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int weakCount = csr->weaklyConnectedComponents(weak, workerThreads);
+        int strongCount = csr->stronglyConnectedComponents(strong);
+        double ms = elapsedWallMillis(start);
+
+        int mainWeak = largestLabel(weak, n, weakCount);
+        int mainStrong = largestLabel(strong, n, strongCount);
+        cout << "Weakly connected components: " << weakCount << endl;
+        cout << "Strongly connected components: " << strongCount << endl;
+        printOutside("Cut off from the main network", weak, mainWeak, n);
+        printOutside("Cannot both reach and be reached from the main network", strong, mainStrong, n);
+        cout << "Analysis took " << ms << " ms." << endl;
+        delete[] weak;
+        delete[] strong;
+    }
+
+    static int largestLabel(const int* labels, int n, int count) {
+        int* sizes = new int[count];
+        for (int c = 0; c < count; ++c) sizes[c] = 0;
+        for (int v = 0; v < n; ++v) sizes[labels[v]]++;
+        int best = 0;
+        for (int c = 1; c < count; ++c) {
+            if (sizes[c] > sizes[best]) best = c;
+        }
+        delete[] sizes;
+        return best;
+    }
+
+    void printOutside(const string& title, const int* labels, int mainLabel, int n) {
+        const int MAX_LISTED = 20;
+        int outside = 0;
+        cout << title << ": ";
+        for (int v = 0; v < n; ++v) {
+            if (labels[v] == mainLabel) continue;
+            if (outside < MAX_LISTED) cout << csrSnapshot->vertexIDs[v] << " ";
+            outside++;
+        }
+        if (outside == 0) cout << "none";
+        else if (outside > MAX_LISTED) cout << "... (" << outside << " locations)";
+        cout << endl;
+    }
+
+    // How many locations are reachable within each number of road segments
+    void hopReachability(int startID) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        CSRGraph* csr = getRoutingGraph();
+        int start = csr->indexOf(startID);
+        if (start == -1) {
+            cout << "BFS Error: Start vertex " << startID << " not found." << endl;
+            return;
+        }
+        cout << "\n--- Hop-count Reachability from " << startID << " ---" << endl;
+        int* hops = new int[csr->numVertices];
+        DirectionOptimizingBFS bfs(*csr, workerThreads);
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        int reached = bfs.computeHops(start, hops);
+        double ms = elapsedWallMillis(begin);
+        int maxHops = 0;
+        for (int v = 0; v < csr->numVertices; ++v) {
+            if (hops[v] > maxHops) maxHops = hops[v];
+        }
+        int* perLevel = new int[maxHops + 1];
+        for (int h = 0; h <= maxHops; ++h) perLevel[h] = 0;
+        for (int v = 0; v < csr->numVertices; ++v) {
+            if (hops[v] >= 0) perLevel[hops[v]]++;
+        }
+        cout << "Hops\tLocations" << endl;
+        for (int h = 0; h <= maxHops; ++h) cout << h << "\t" << perLevel[h] << endl;
+        cout << "Reachable: " << reached << " of " << csr->numVertices << " locations (" << ms << " ms)" << endl;
+        delete[] perLevel;
+        delete[] hops;
+    }
+
+    void performDFS(int startID) {
+        if (!cityGraph) {
+            cout << "Error: City graph not initialized for Network Service." << endl;
+            return;
+        }
+        cout << "\n--- Performing DFS ---" << endl;
+        getRoutingGraph()->DFS(startID);
+    }
+};
+
+
+// --- Routing Benchmarks (synthetic grid road networks) ---
+class RoutingBenchmark {
+public:
+    // True when two distance arrays of length n agree everywhere
+    static bool sameDistances(const int* a, const int* b, int n) {
+        for (int i = 0; i < n; ++i) {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
+
+    // rows x cols grid of intersections 10 units apart, with two-way roads of random
+    // travel time 10..20 (free flow plus congestion). Vertex IDs are 1..rows*cols, row-major.
+    static void buildGridNetwork(Graph& graph, int rows, int cols, unsigned int seed = 2024) {
+        SimpleRandom rng(seed);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                graph.addVertex(r * cols + c + 1, "Grid", c * 10.0, r * 10.0);
+            }
+        }
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int id = r * cols + c + 1;
+                if (c + 1 < cols) {
+                    int w = rng.nextInRange(10, 20);
+                    graph.addEdge(id, id + 1, w);
+                    graph.addEdge(id + 1, id, w);
+                }
+                if (r + 1 < rows) {
+                    int w = rng.nextInRange(10, 20);
+                    graph.addEdge(id, id + cols, w);
+                    graph.addEdge(id + cols, id, w);
+                }
+            }
+        }
+    }
+
+    // Full single-source Dijkstra with each frontier structure, on growing grids
+    static void runPriorityQueueBenchmark() {
+        cout << "\n--- Benchmark: Dijkstra priority queues (ms per query) ---" << endl;
+        cout << "Vertices\tSortedList\tDaryHeap\tLazyHeap" << endl;
+        int sides[] = {25, 50, 100, 200};
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            GraphSearchState state(grid.numVertices);
+            int last = grid.numVertices - 1;
+
+            clock_t start = clock();
+            grid.computeDijkstra(1, state, PQ_SORTED_LIST);
+            double sortedMs = elapsedMillis(start);
+            int checkDist = state.dist[last];
+
+            start = clock();
+            grid.computeDijkstra(1, state, PQ_INDEXED_DARY_HEAP);
+            double heapMs = elapsedMillis(start);
+            bool same = state.dist[last] == checkDist;
+
+            start = clock();
+            grid.computeDijkstra(1, state, PQ_LAZY_BINARY_HEAP);
+            double lazyMs = elapsedMillis(start);
+            same = same && state.dist[last] == checkDist;
+
+            cout << grid.numVertices << "\t\t" << sortedMs << "\t\t" << heapMs << "\t\t" << lazyMs;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // Same heap-based Dijkstra on the linked-list Graph and on its CSR snapshot
+    static void runCSRBenchmark() {
+        cout << "\n--- Benchmark: linked-list Graph vs CSR snapshot (ms) ---" << endl;
+        cout << "Vertices\tGraph\t\tCSR build\tCSR query" << endl;
+        int sides[] = {50, 100, 200, 300};
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+
+            GraphSearchState state(grid.numVertices);
+            clock_t start = clock();
+            grid.computeDijkstra(1, state);
+            double graphMs = elapsedMillis(start);
+
+            start = clock();
+            CSRGraph csr(grid);
+            double buildMs = elapsedMillis(start);
+
+            int* dist = new int[csr.numVertices];
+            start = clock();
+            csr.computeDistances(csr.indexOf(1), dist);
+            double csrMs = elapsedMillis(start);
+
+            bool same = true;
+            for (int v = 0; v < csr.numVertices; ++v) {
+                if (dist[v] != state.dist[v]) same = false;
+            }
+            delete[] dist;
+
+            cout << grid.numVertices << "\t\t" << graphMs << "\t\t" << buildMs << "\t\t" << csrMs;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // Bulk-loading cost of addVertex/addEdge (each addEdge does two ID lookups)
+    static void runGraphLoadBenchmark() {
+        cout << "\n--- Benchmark: bulk graph loading ---" << endl;
+        cout << "Vertices\tEdges\t\tLoad ms" << endl;
+        int sides[] = {100, 250, 500};
+        for (int i = 0; i < 3; ++i) {
+            Graph grid;
+            clock_t start = clock();
+            buildGridNetwork(grid, sides[i], sides[i]);
+            double loadMs = elapsedMillis(start);
+            cout << grid.numVertices << "\t\t" << grid.numEdges << "\t\t" << loadMs << endl;
+        }
+    }
+
+    // Random source/target pairs: full single-source run vs early-terminating point-to-point query
+    static void runPointToPointBenchmark() {
+        cout << "\n--- Benchmark: full Dijkstra vs point-to-point query (avg ms, avg settled) ---" << endl;
+        cout << "Vertices\tFull ms\t\tP2P ms\t\tP2P settled" << endl;
+        int sides[] = {50, 100, 200, 300};
+        const int queries = 50;
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+            SearchWorkspace ws(csr.numVertices);
+            int* dist = new int[csr.numVertices];
+            SimpleRandom rng(7);
+
+            double fullMs = 0, p2pMs = 0;
+            long long settled = 0;
+            bool same = true;
+            for (int q = 0; q < queries; ++q) {
+                int s = rng.nextInRange(1, csr.numVertices);
+                int t = rng.nextInRange(1, csr.numVertices);
+
+                clock_t start = clock();
+                csr.computeDistances(csr.indexOf(s), dist);
+                fullMs += elapsedMillis(start);
+
+                start = clock();
+                RouteResult r = csr.shortestPath(s, t, ws);
+                p2pMs += elapsedMillis(start);
+                settled += r.settledCount;
+                if (r.cost != dist[csr.indexOf(t)]) same = false;
+            }
+            delete[] dist;
+
+            cout << csr.numVertices << "\t\t" << fullMs / queries << "\t\t" << p2pMs / queries << "\t\t" << settled / queries;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // Same random pairs answered by Dijkstra and by A*, comparing settled vertices
+    static void runAStarBenchmark() {
+        cout << "\n--- Benchmark: Dijkstra vs A* point-to-point (avg per query) ---" << endl;
+        cout << "Vertices\tDijkstra ms\tsettled\t\tA* ms\t\tsettled" << endl;
+        int sides[] = {50, 100, 200, 300};
+        const int queries = 50;
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+            SearchWorkspace ws(csr.numVertices);
+            SimpleRandom rng(11);
+
+            double dijkstraMs = 0, aStarMs = 0;
+            long long dijkstraSettled = 0, aStarSettled = 0;
+            bool same = true;
+            for (int q = 0; q < queries; ++q) {
+                int s = rng.nextInRange(1, csr.numVertices);
+                int t = rng.nextInRange(1, csr.numVertices);
+
+                clock_t start = clock();
+                RouteResult plain = csr.shortestPath(s, t, ws);
+                dijkstraMs += elapsedMillis(start);
+                dijkstraSettled += plain.settledCount;
+
+                start = clock();
+                RouteResult guided = csr.aStarPath(s, t, ws);
+                aStarMs += elapsedMillis(start);
+                aStarSettled += guided.settledCount;
+                if (plain.cost != guided.cost) same = false;
+            }
+
+            cout << csr.numVertices << "\t\t" << dijkstraMs / queries << "\t\t" << dijkstraSettled / queries
+                 << "\t\t" << aStarMs / queries << "\t\t" << aStarSettled / queries;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // Long cross-city routes (west edge to east edge) by unidirectional and bidirectional Dijkstra
+    static void runBidirectionalBenchmark() {
+        cout << "\n--- Benchmark: Dijkstra vs bidirectional Dijkstra, west to east ---" << endl;
+        cout << "Vertices\tDijkstra ms\tsettled\t\tBidir ms\tsettled" << endl;
+        int sides[] = {50, 100, 200, 300};
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+            SearchWorkspace forward(csr.numVertices);
+            SearchWorkspace backward(csr.numVertices);
+            int middleRow = sides[i] / 2;
+            int s = middleRow * sides[i] + 1;
+            int t = middleRow * sides[i] + sides[i];
+
+            clock_t start = clock();
+            RouteResult plain = csr.shortestPath(s, t, forward);
+            double plainMs = elapsedMillis(start);
+
+            start = clock();
+            RouteResult bidir = csr.bidirectionalPath(s, t, forward, backward);
+            double bidirMs = elapsedMillis(start);
+
+            cout << csr.numVertices << "\t\t" << plainMs << "\t\t" << plain.settledCount
+                 << "\t\t" << bidirMs << "\t\t" << bidir.settledCount;
+            if (plain.cost != bidir.cost) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // Preprocessing cost and query time of Contraction Hierarchies against plain Dijkstra
+    static void runContractionHierarchyBenchmark() {
+        cout << "\n--- Benchmark: Contraction Hierarchies (avg per query) ---" << endl;
+        cout << "Vertices\tBuild ms\tShortcuts\tDijkstra us\tCH us\t\tCH settled" << endl;
+        int sides[] = {30, 60, 100};
+        const int queries = 200;
+        for (int i = 0; i < 3; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+            SearchWorkspace forward(csr.numVertices);
+            SearchWorkspace backward(csr.numVertices);
+
+            clock_t start = clock();
+            ContractionHierarchy ch;
+            ch.build(csr);
+            double buildMs = elapsedMillis(start);
+
+            SimpleRandom rng(13);
+            double dijkstraMs = 0, chMs = 0;
+            long long chSettled = 0;
+            bool same = true;
+            for (int q = 0; q < queries; ++q) {
+                int s = rng.nextInRange(1, csr.numVertices);
+                int t = rng.nextInRange(1, csr.numVertices);
+
+                start = clock();
+                RouteResult plain = csr.shortestPath(s, t, forward);
+                dijkstraMs += elapsedMillis(start);
+
+                start = clock();
+                RouteResult fast = ch.query(s, t, forward, backward);
+                chMs += elapsedMillis(start);
+                chSettled += fast.settledCount;
+                if (plain.cost != fast.cost) same = false;
+            }
+
+            cout << csr.numVertices << "\t\t" << buildMs << "\t\t" << ch.numShortcuts << "\t\t"
+                 << 1000.0 * dijkstraMs / queries << "\t\t" << 1000.0 * chMs / queries << "\t\t" << chSettled / queries;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
+
+    // ALT with 8 landmarks against straight-line A* on the same random pairs
+    static void runLandmarkBenchmark() {
+        cout << "\n--- Benchmark: A* (straight line) vs ALT, 8 landmarks (avg per query) ---" << endl;
+        cout << "Vertices\tTables ms\tA* ms\t\tsettled\t\tALT ms\t\tsettled" << endl;
+        int sides[] = {50, 100, 200, 300};
+        const int queries = 50;
+        for (int i = 0; i < 4; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+            SearchWorkspace ws(csr.numVertices);
+
+            clock_t start = clock();
+            LandmarkIndex alt(8);
+            alt.build(csr);
+            double tablesMs = elapsedMillis(start);
+
+            SimpleRandom rng(17);
+            double aStarMs = 0, altMs = 0;
+            long long aStarSettled = 0, altSettled = 0;
+            bool same = true;
+            for (int q = 0; q < queries; ++q) {
+                int s = rng.nextInRange(1, csr.numVertices);
+                int t = rng.nextInRange(1, csr.numVertices);
+
+                start = clock();
+                RouteResult geo = csr.aStarPath(s, t, ws);
+                aStarMs += elapsedMillis(start);
+                aStarSettled += geo.settledCount;
+
+                start = clock();
+                RouteResult landmark = alt.query(csr, s, t, ws);
+                altMs += elapsedMillis(start);
+                altSettled += landmark.settledCount;
+                if (geo.cost != landmark.cost) same = false;
+            }
+
+            cout << csr.numVertices << "\t\t" << tablesMs << "\t\t" << aStarMs / queries << "\t\t" << aStarSettled / queries
+                 << "\t\t" << altMs / queries << "\t\t" << altSettled / queries;
+            if (!same) cout << "\t(MISMATCH)";
+            cout << endl;
+        }
+    }
 
-    CitizenManagement() {}
+    // Full distance field on a 300x300 grid for several bucket widths on one thread, then width
+    // 20 at 1/2/4/8/16 threads (wall-clock time), every run checked against Dijkstra. Width 20
+    // is the largest road weight: ~365 phases against ~3600 for width 1, and every phase ends in
+    // barriers, so it is the better width once the buckets are split across workers
+    static void runDeltaSteppingBenchmark() {
+        cout << "\n--- Benchmark: delta-stepping vs Dijkstra, full SSSP on 90000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 300, 300);
+        CSRGraph csr(grid);
+        int source = csr.indexOf(45150); // Near the middle
+        int* expected = new int[csr.numVertices];
+        int* dist = new int[csr.numVertices];
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        csr.computeDistances(source, expected);
+        cout << "Dijkstra: " << elapsedWallMillis(start) << " ms" << endl;
+
+        cout << "Delta\tms\tPhases\tRelaxations\tIdentical" << endl;
+        int widths[] = {1, 10, 20, 40, 100, 400};
+        for (int i = 0; i < 6; ++i) {
+            DeltaSteppingSSSP solver(csr, widths[i]);
+            start = chrono::steady_clock::now();
+            solver.computeDistances(source, dist);
+            double ms = elapsedWallMillis(start);
+            cout << widths[i] << "\t" << ms << "\t" << solver.phases << "\t" << solver.relaxations << "\t\t" << (sameDistances(dist, expected, csr.numVertices) ? "yes" : "NO") << endl;
+        }
 
-    void addCitizen(int id, string name, string address) {
-        if (citizenList.findNode(id)) {
-            cout << "Citizen with ID " << id << " already exists." << endl;
-            return;
+        const int THREAD_SWEEP_WIDTH = 20;
+        cout << "\nDelta " << THREAD_SWEEP_WIDTH << ", " << hardwareThreads() << " hardware thread(s) available" << endl;
+        cout << "Threads\tms\tSpeedup\tIdentical" << endl;
+        int threadCounts[] = {1, 2, 4, 8, 16};
+        double oneThreadMs = 0;
+        for (int i = 0; i < 5; ++i) {
+            DeltaSteppingSSSP solver(csr, THREAD_SWEEP_WIDTH, threadCounts[i]);
+            start = chrono::steady_clock::now();
+            solver.computeDistances(source, dist);
+            double ms = elapsedWallMillis(start);
+            if (i == 0) oneThreadMs = ms;
+            cout << threadCounts[i] << "\t" << ms << "\t" << (ms > 0 ? oneThreadMs / ms : 0) << "x\t" << (sameDistances(dist, expected, csr.numVertices) ? "yes" : "NO") << endl;
         }
-        citizenList.insertAtTail(id, name, address); // Using NodeLL fields for citizen data
-        citizenNameTrie.insert(name);
-        cout << "Citizen " << name << " added." << endl;
+        delete[] expected;
+        delete[] dist;
     }
 
-    void findCitizen(int id) {
-        NodeLL* citizenNode = citizenList.findNode(id);
-        if (citizenNode) {
-            cout << "Citizen Found: ID=" << citizenNode->id << ", Name=" << citizenNode->name << ", Address=" << citizenNode->data1 << endl;
-        } else {
-            cout << "Citizen with ID " << id << " not found." << endl;
+    // Citizen registries of 20k, 200k and 2M residents: bulk load with the duplicate-ID check
+    // done through CitizenIndex vs ManualLinkedList::findNode (quadratic, only run on the
+    // smallest size), random lookups both ways, then removing half the residents by ID
+    static void runCitizenIndexBenchmark() {
+        cout << "\n--- Benchmark: citizen registry, hashed ID index vs linear findNode ---" << endl;
+        cout << "Citizens\tIndexed load (ms)\tLinear load (ms)\tIndexed find (us)\tLinear find (us)\tRemove half (ms)\tLongest probe" << endl;
+        int sizes[] = {20000, 200000, 2000000};
+        for (int s = 0; s < 3; ++s) {
+            int n = sizes[s];
+            int* ids = new int[n];
+            for (int i = 0; i < n; ++i) ids[i] = (int)(((unsigned int)i * 2654435761u) & 0x7FFFFFFFu); // Distinct, scattered IDs
+
+            ManualLinkedList registry;
+            CitizenIndex index;
+            clock_t start = clock();
+            for (int i = 0; i < n; ++i) {
+                if (index.find(ids[i])) continue;
+                index.insert(ids[i], registry.insertAtTail(ids[i], "Citizen", "Address"));
+            }
+            double indexedLoadMs = elapsedMillis(start);
+
+            double linearLoadMs = -1;
+            if (n <= 20000) {
+                ManualLinkedList linearRegistry;
+                start = clock();
+                for (int i = 0; i < n; ++i) {
+                    if (linearRegistry.findNode(ids[i])) continue;
+                    linearRegistry.insertAtTail(ids[i], "Citizen", "Address");
+                }
+                linearLoadMs = elapsedMillis(start);
+            }
+
+            SimpleRandom rng(25 + s);
+            const int INDEXED_LOOKUPS = 1000000, LINEAR_LOOKUPS = 200;
+            long long found = 0;
+            start = clock();
+            for (int q = 0; q < INDEXED_LOOKUPS; ++q) {
+                if (index.find(ids[rng.next() % (unsigned int)n])) found++;
+            }
+            double indexedFindUs = 1000.0 * elapsedMillis(start) / INDEXED_LOOKUPS;
+            start = clock();
+            for (int q = 0; q < LINEAR_LOOKUPS; ++q) {
+                if (registry.findNode(ids[rng.next() % (unsigned int)n])) found++;
+            }
+            double linearFindUs = 1000.0 * elapsedMillis(start) / LINEAR_LOOKUPS;
+
+            int probe = index.longestProbe();
+            start = clock();
+            for (int i = 0; i < n; i += 2) {
+                NodeLL* node = index.find(ids[i]);
+                index.remove(ids[i]);
+                registry.removeNode(node);
+            }
+            double removeMs = elapsedMillis(start);
+
+            cout << n << "\t\t" << indexedLoadMs << "\t\t\t";
+            if (linearLoadMs < 0) cout << "-"; else cout << linearLoadMs;
+            cout << "\t\t\t" << indexedFindUs << "\t\t\t" << linearFindUs << "\t\t\t" << removeMs << "\t\t\t" << probe;
+            if (found != INDEXED_LOOKUPS + LINEAR_LOOKUPS || registry.getSize() != index.count) cout << " (MISMATCH)";
+            cout << endl;
+            delete[] ids;
         }
     }
 
-    void displayAllCitizens() {
-        cout << "\n--- All Citizens ---" << endl;
-        citizenList.displayList();
+    // Evacuating 2500 people from 25 districts in one corner of a 150x150 grid to 8 shelters
+    // across the far half over roads with capacities 20-200: plain SSP (one path per Dijkstra)
+    // vs one blocking flow per Dijkstra
+    static void runEvacuationBenchmark() {
+        cout << "\n--- Benchmark: min-cost flow evacuation on a 150x150 grid ---" << endl;
+        const int SIDE = 150;
+        Graph grid;
+        buildGridNetwork(grid, SIDE, SIDE);
+        SimpleRandom rng(24);
+        for (int i = 0; i < grid.numVertices; ++i) {
+            GraphVertexNode* v = grid.vertexByIndex[i];
+            for (GraphEdgeNode* edge = v->adjListHead; edge; edge = edge->next) grid.setEdgeCapacity(v->id, edge->toVertexID, rng.nextInRange(20, 200));
+        }
+        int districts[25], populations[25], shelters[8], shelterCaps[8];
+        for (int i = 0; i < 25; ++i) {
+            districts[i] = (SIDE / 30 + (i / 5) * (SIDE / 30)) * SIDE + SIDE / 30 + (i % 5) * (SIDE / 30) + 1;
+            populations[i] = 100;
+        }
+        for (int i = 0; i < 8; ++i) {
+            shelters[i] = (SIDE - SIDE / 10 - (i / 4) * (SIDE / 3)) * SIDE + SIDE / 10 + (i % 4) * (SIDE / 4) + 1;
+            shelterCaps[i] = 500;
+        }
+        long long checkCost = -1;
+        for (int mode = 0; mode < 2; ++mode) {
+            MinCostFlow flow(grid, districts, populations, 25, shelters, shelterCaps, 8);
+            clock_t start = clock();
+            flow.solve(mode == 0);
+            double ms = elapsedMillis(start);
+            double slowest = 0;
+            for (int i = 0; i < flow.numPhases; ++i) {
+                if (flow.phases[i].ms > slowest) slowest = flow.phases[i].ms;
+            }
+            cout << (mode == 0 ? "One path per Dijkstra:   " : "Blocking flow per phase: ") << ms << " ms, " << flow.numPhases << " phases ("
+                 << (flow.numPhases > 0 ? ms / flow.numPhases : 0) << " ms avg, " << slowest << " ms slowest), " << flow.totalFlow << " people, cost " << flow.totalCost;
+            if (checkCost != -1 && checkCost != flow.totalCost) cout << " (MISMATCH)";
+            cout << endl;
+            checkCost = flow.totalCost;
+        }
     }
 
-    void suggestCitizenNames(string prefix) {
-        cout << "\n--- Citizen Name Suggestions for prefix '" << prefix << "' ---" << endl;
-        ManualLinkedList* suggestions = citizenNameTrie.getSuggestions(prefix);
-        if (suggestions->isEmpty()) {
-            cout << "No suggestions found." << endl;
-        } else {
-            suggestions->displayList();
+    // Minimum spanning forest on grids of 1M and 4M road entries: Boruvka with the Kruskal
+    // finish vs plain Kruskal over the same contiguous edge array
+    static void runSpanningTreeBenchmark() {
+        cout << "\n--- Benchmark: minimum spanning tree (ms) ---" << endl;
+        cout << "Roads\t\tEdge array\tBoruvka\t\tRounds\tKruskal\t\tSame cost" << endl;
+        int sides[] = {500, 1000};
+        for (int i = 0; i < 2; ++i) {
+            Graph grid;
+            buildGridNetwork(grid, sides[i], sides[i]);
+            CSRGraph csr(grid);
+
+            clock_t start = clock();
+            SpanningTreeBuilder boruvkaBuilder(csr);
+            double arrayMs = elapsedMillis(start);
+            SpanningForest boruvkaForest;
+            start = clock();
+            boruvkaBuilder.boruvka(boruvkaForest);
+            double boruvkaMs = elapsedMillis(start);
+
+            SpanningTreeBuilder kruskalBuilder(csr);
+            SpanningForest kruskalForest;
+            start = clock();
+            kruskalBuilder.kruskal(kruskalForest);
+            double kruskalMs = elapsedMillis(start);
+
+            cout << csr.numEdges << "\t\t" << arrayMs << "\t\t" << boruvkaMs << "\t\t" << boruvkaForest.boruvkaRounds << "\t" << kruskalMs << "\t\t"
+                 << (boruvkaForest.totalCost == kruskalForest.totalCost && boruvkaForest.components == 1 ? "yes" : "NO") << endl;
+            if (i == 1) runBoruvkaThreadSweep(csr, kruskalForest.totalCost);
         }
-        delete suggestions; // Clean up the suggestions list
     }
-};
-
-class TrafficManagement {
-public:
-    ManualQueue intersectionQueueA; // Example: An intersection with a priority queue
-    // Graph* cityRoadNetwork; // Pointer to the main city graph
 
-    TrafficManagement(/*Graph* roadNetwork*/) {
-        // cityRoadNetwork = roadNetwork;
+    // Boruvka on 1/2/4/8/16 threads (wall clock, edge array copy excluded); the forest must
+    // keep the cost Kruskal found
+    static void runBoruvkaThreadSweep(const CSRGraph& csr, long long expectedCost) {
+        cout << "Boruvka threads on " << csr.numEdges << " roads:" << endl;
+        double oneThreadMs = 0;
+        for (int threads = 1; threads <= 16; threads *= 2) {
+            SpanningTreeBuilder builder(csr);
+            SpanningForest forest;
+            chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+            builder.boruvka(forest, 4096, threads);
+            double ms = elapsedWallMillis(wallStart);
+            if (threads == 1) oneThreadMs = ms;
+            cout << "  " << threads << " thread(s): " << ms << " ms (" << (ms > 0 ? oneThreadMs / ms : 0) << "x), same cost: "
+                 << (forest.totalCost == expectedCost ? "yes" : "NO") << endl;
+        }
     }
 
-    void vehicleArrives(string plate, string type, int priority = 1) { // default priority 1
-        if (type == "EMERGENCY") { // Simple rule for emergency
-            priority = 0;
+    // District overlay on a 300x300 grid: partition and full customization cost (then
+    // customization on 1/2/4/8/16 threads, wall clock, which must give the same cliques),
+    // queries against plain Dijkstra, and re-customizing after one road change vs customizing
+    // everything
+    static void runOverlayBenchmark() {
+        cout << "\n--- Benchmark: district overlay (CRP-style) on a 300x300 grid ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 300, 300);
+        CSRGraph csr(grid);
+        SearchWorkspace ws(csr.numVertices);
+        OverlayWorkspace overlayWs(csr.numVertices);
+        OverlayGraph overlay;
+        clock_t start = clock();
+        overlay.build(csr, 128, 3, overlayWs);
+        double buildMs = elapsedMillis(start);
+        start = clock();
+        overlay.customize(csr, overlayWs);
+        double customizeMs = elapsedMillis(start);
+        cout << "Partition + customization: " << buildMs << " ms (" << overlay.numCells[1] << " level-1 cells, " << overlay.cutEdges
+             << " of " << csr.numEdges << " roads cut, " << (overlay.cliqueBytes() / 1024) << " KB of cliques)" << endl;
+        cout << "Customization alone: " << customizeMs << " ms for " << overlay.totalCells() << " cells" << endl;
+
+        int* reference[OverlayGraph::MAX_LEVELS + 1];
+        for (int l = 1; l <= overlay.numLevels; ++l) {
+            int entries = overlay.cliqueOffsets[l][overlay.numCells[l]];
+            reference[l] = new int[entries > 0 ? entries : 1];
+            for (int i = 0; i < entries; ++i) reference[l][i] = overlay.cliqueWeights[l][i];
         }
-        intersectionQueueA.priorityEnqueue(plate, type, priority);
-        cout << "Vehicle " << plate << " (" << type << ", Prio " << priority <<") arrived at intersection A." << endl;
+        double oneThreadMs = 0;
+        for (int threads = 1; threads <= 16; threads *= 2) {
+            chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+            overlay.customize(csr, overlayWs, threads);
+            double ms = elapsedWallMillis(wallStart);
+            if (threads == 1) oneThreadMs = ms;
+            bool sameCliques = true;
+            for (int l = 1; l <= overlay.numLevels; ++l) {
+                for (int i = 0; i < overlay.cliqueOffsets[l][overlay.numCells[l]]; ++i) {
+                    if (overlay.cliqueWeights[l][i] != reference[l][i]) sameCliques = false;
+                }
+            }
+            cout << "Customization, " << threads << " thread(s): " << ms << " ms (" << (ms > 0 ? oneThreadMs / ms : 0) << "x), same cliques: "
+                 << (sameCliques ? "yes" : "NO") << endl;
+        }
+        for (int l = 1; l <= overlay.numLevels; ++l) delete[] reference[l];
+
+        const int QUERIES = 100;
+        int sources[QUERIES], targets[QUERIES];
+        SimpleRandom rng(22);
+        for (int q = 0; q < QUERIES; ++q) {
+            sources[q] = rng.nextInRange(1, csr.numVertices);
+            targets[q] = rng.nextInRange(1, csr.numVertices);
+        }
+        long long dijkstraSettled = 0, overlaySettled = 0;
+        int checkCosts[QUERIES];
+        start = clock();
+        for (int q = 0; q < QUERIES; ++q) {
+            RouteResult r = csr.shortestPath(sources[q], targets[q], ws);
+            checkCosts[q] = r.cost;
+            dijkstraSettled += r.settledCount;
+        }
+        double dijkstraMs = elapsedMillis(start) / QUERIES;
+        bool same = true;
+        start = clock();
+        for (int q = 0; q < QUERIES; ++q) {
+            RouteResult r = overlay.query(csr, sources[q], targets[q], overlayWs);
+            if (r.cost != checkCosts[q]) same = false;
+            overlaySettled += r.settledCount;
+        }
+        double overlayMs = elapsedMillis(start) / QUERIES;
+        cout << "Dijkstra: " << dijkstraMs << " ms/query, " << (dijkstraSettled / QUERIES) << " settled" << endl;
+        cout << "Overlay:  " << overlayMs << " ms/query, " << (overlaySettled / QUERIES) << " settled (paths unpacked)" << endl;
+
+        // One road in the middle of the city gets slower; the overlay takes the new weight
+        // directly and keeps using the old snapshot for its topology
+        int middle = 150 * 300 + 150 + 1;
+        grid.updateEdgeWeight(middle, middle + 1, 500);
+        CSRGraph updated(grid);
+        start = clock();
+        int cells = overlay.customizeEdge(csr, csr.indexOf(middle), csr.indexOf(middle + 1), 500, overlayWs);
+        double incrementalMs = elapsedMillis(start);
+        for (int q = 0; q < QUERIES; ++q) {
+            if (overlay.query(csr, sources[q], targets[q], overlayWs).cost != updated.shortestPath(sources[q], targets[q], ws).cost) same = false;
+        }
+        cout << "After a road change: " << cells << " cells re-customized in " << incrementalMs << " ms (vs " << customizeMs << " ms for all)" << endl;
+        cout << "Same costs as Dijkstra: " << (same ? "yes" : "NO") << endl;
     }
 
-    void vehicleDeparts() {
-        if (intersectionQueueA.isEmpty()) {
-            cout << "No vehicles to depart from intersection A." << endl;
+    // Shared by the writer (worker 0) and the reader threads of runSnapshotBenchmark
+    struct SnapshotRace {
+        NetworkService& service;
+        Graph& grid;
+        int target;
+        int publishes;
+        atomic<bool> done;
+        atomic<int> queries;
+        atomic<int> unstable;  // Pins whose two answers differed
+        atomic<int> backwards; // Pins that got an older version than the reader's previous pin
+
+        SnapshotRace(NetworkService& s, Graph& g, int t, int count)
+            : service(s), grid(g), target(t), publishes(count), done(false), queries(0), unstable(0), backwards(0) {}
+    };
+
+    static void snapshotRaceWorker(void* context, int worker) {
+        SnapshotRace& race = *(SnapshotRace*)context;
+        if (worker == 0) {
+            SimpleRandom rng(22);
+            for (int round = 0; round < race.publishes; ++round) {
+                for (int e = 0; e < 25; ++e) {
+                    GraphVertexNode* v = race.grid.vertexByIndex[rng.nextInRange(0, race.grid.numVertices - 1)];
+                    if (v->adjListHead) race.grid.updateEdgeWeight(v->id, v->adjListHead->toVertexID, v->adjListHead->weight + 5);
+                }
+                race.service.getRoutingGraph();
+            }
+            race.done.store(true);
             return;
         }
-        QueueNode* departed = intersectionQueueA.dequeue();
-        cout << "Vehicle " << departed->licensePlate << " (" << departed->vehicleType << ") departed from intersection A." << endl;
-        delete departed;
+        SearchWorkspace ws(race.grid.numVertices);
+        int lastEpoch = 0;
+        while (!race.done.load()) {
+            RoadSnapshot* snapshot = race.service.snapshots.pin();
+            int first = snapshot->graph->shortestPath(1, race.target, ws).cost;
+            int second = snapshot->graph->shortestPath(1, race.target, ws).cost;
+            if (first != second) race.unstable++;
+            if (snapshot->epoch < lastEpoch) race.backwards++;
+            lastEpoch = snapshot->epoch;
+            race.service.snapshots.unpin(snapshot);
+            race.queries += 2;
+        }
     }
 
-    void displayIntersectionQueue() {
-        cout << "\n--- Intersection A Queue Status ---" << endl;
-        intersectionQueueA.displayQueue();
+    // Readers pin successive versions of a 200x200 grid while a writer keeps slowing roads and
+    // republishing; every reader must keep getting its own version's answer, and the retired
+    // versions must all be freed once the readers let go. Then the same with reader threads
+    // routing concurrently with the writer.
+    static void runSnapshotBenchmark() {
+        cout << "\n--- Benchmark: pinned routing snapshots during road edits, 200x200 grid ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 200, 200);
+        NetworkService service(&grid);
+        const int READERS = 4, EDITS_PER_VERSION = 25;
+        RoadSnapshot* pinned[READERS];
+        int expected[READERS];
+        int target = grid.numVertices;
+        SimpleRandom rng(21);
+        double publishMs = 0;
+        for (int r = 0; r < READERS; ++r) {
+            clock_t start = clock();
+            pinned[r] = service.pinRoutingGraph();
+            publishMs += elapsedMillis(start);
+            expected[r] = pinned[r]->graph->shortestPath(1, target).cost;
+
+            // Writer: random slowdowns plus the roads leaving location 1, so each version's
+            // answer is different
+            for (int e = 0; e < EDITS_PER_VERSION; ++e) {
+                GraphVertexNode* v = grid.vertexByIndex[rng.nextInRange(0, grid.numVertices - 1)];
+                if (v->adjListHead) grid.updateEdgeWeight(v->id, v->adjListHead->toVertexID, v->adjListHead->weight + 5);
+            }
+            for (GraphEdgeNode* edge = grid.findVertex(1)->adjListHead; edge; edge = edge->next) grid.updateEdgeWeight(1, edge->toVertexID, edge->weight + 10);
+        }
+        cout << "Published " << service.snapshots.epoch << " versions, " << (publishMs / READERS) << " ms per publish" << endl;
+        cout << "Retired versions kept alive by readers: " << service.snapshots.numRetired << endl;
+
+        bool consistent = true;
+        clock_t start = clock();
+        for (int round = 0; round < 10; ++round) {
+            for (int r = 0; r < READERS; ++r) {
+                if (pinned[r]->graph->shortestPath(1, target).cost != expected[r]) consistent = false;
+            }
+        }
+        double queryMs = elapsedMillis(start) / (10 * READERS);
+        for (int r = 0; r < READERS; ++r) cout << "Reader " << (r + 1) << " (version " << pinned[r]->epoch << "): cost " << expected[r] << endl;
+        cout << "Latest version: cost " << service.getRoutingGraph()->shortestPath(1, target).cost << endl;
+        cout << "Pinned answers unchanged by later edits: " << (consistent ? "yes" : "NO") << ", " << queryMs << " ms per query" << endl;
+
+        for (int r = 0; r < READERS; ++r) service.unpinRoutingGraph(pinned[r]);
+        cout << "After readers finish: " << service.snapshots.numRetired << " retired versions left, " << service.snapshots.reclaimed << " reclaimed" << endl;
+
+        SnapshotRace race(service, grid, target, 20);
+        int firstEpoch = service.snapshots.epoch;
+        chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+        runWorkers(READERS + 1, snapshotRaceWorker, &race);
+        double raceMs = elapsedWallMillis(wallStart);
+        service.snapshots.reclaim();
+        cout << READERS << " reader threads during " << (service.snapshots.epoch - firstEpoch) << " publishes: " << race.queries.load() << " queries in "
+             << raceMs << " ms, answers stable within a pin: " << (race.unstable.load() == 0 ? "yes" : "NO")
+             << ", versions in order: " << (race.backwards.load() == 0 ? "yes" : "NO") << endl;
+        cout << "After reader threads finish: " << service.snapshots.numRetired << " retired versions left, " << service.snapshots.reclaimed << " reclaimed" << endl;
     }
-};
 
-class ParkingManagement {
-public:
-    ManualStack parkingLotTower1;
-    int capacity;
+    // Exact Brandes on a 60x60 grid with the sources split over 1/2/4/8/16 threads (wall
+    // clock; only the summation order differs, so the scores should match), then sampled
+    // estimates compared against the exact top-10
+    static void runBetweennessBenchmark() {
+        cout << "\n--- Benchmark: betweenness centrality on a 60x60 grid ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 60, 60);
+        CSRGraph csr(grid);
+        int n = csr.numVertices;
+        double* exact = new double[n];
+        double* scores = new double[n];
+        int exactTop[10], sampledTop[10];
+        double exactMs = 0;
+        for (int workers = 1; workers <= 16; workers *= 2) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            BetweennessCentrality::computeExact(csr, workers == 1 ? exact : scores, workers);
+            double ms = elapsedWallMillis(start);
+            if (workers == 1) exactMs = ms;
+            double maxDiff = 0;
+            for (int v = 0; workers > 1 && v < n; ++v) {
+                double diff = scores[v] > exact[v] ? scores[v] - exact[v] : exact[v] - scores[v];
+                if (diff > maxDiff) maxDiff = diff;
+            }
+            cout << "Exact, " << workers << " thread(s): " << ms << " ms (" << (ms > 0 ? exactMs / ms : 0) << "x), max difference from 1 thread " << maxDiff << endl;
+        }
+        BetweennessCentrality::topVertices(exact, n, 10, exactTop);
+        int sampleCounts[] = {64, 256, 1024};
+        for (int s = 0; s < 3; ++s) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            BetweennessCentrality::computeSampled(csr, sampleCounts[s], scores);
+            double ms = elapsedWallMillis(start);
+            BetweennessCentrality::topVertices(scores, n, 10, sampledTop);
+            int overlap = 0;
+            for (int i = 0; i < 10; ++i)
+                for (int j = 0; j < 10; ++j) overlap += sampledTop[i] == exactTop[j];
+            double worstError = 0;
+            for (int i = 0; i < 10; ++i) {
+                int v = exactTop[i];
+                double error = (scores[v] - exact[v]) / exact[v];
+                if (error < 0) error = -error;
+                if (error > worstError) worstError = error;
+            }
+            cout << "Sampled " << sampleCounts[s] << " sources: " << ms << " ms (" << (ms > 0 ? exactMs / ms : 0) << "x faster), top-10 overlap "
+                 << overlap << "/10, worst top-10 error " << (worstError * 100) << "%" << endl;
+        }
+        delete[] exact;
+        delete[] scores;
+    }
 
-    ParkingManagement(int cap = 10) : capacity(cap) {}
+    // Writes a 500x500 grid as a CSV edge list (~1M lines), then imports it with the streaming
+    // importer and with a getline/stoi loop that builds a std::string per line and field
+    static void runEdgeListImportBenchmark() {
+        cout << "\n--- Benchmark: importing a 1000000-line edge list ---" << endl;
+        const string filename = "routing_benchmark.csv";
+        {
+            Graph grid;
+            buildGridNetwork(grid, 500, 500);
+            ofstream out(filename.c_str(), ios::binary);
+            out << "from,to,weight,name\n";
+            for (int i = 0; i < grid.numVertices; ++i) {
+                GraphVertexNode* v = grid.vertexByIndex[i];
+                for (GraphEdgeNode* edge = v->adjListHead; edge; edge = edge->next) {
+                    out << v->id << "," << edge->toVertexID << "," << edge->weight << ",Jalan " << (v->id % 97) << "\n";
+                }
+            }
+            if (!out) {
+                cout << "Error: Could not write '" << filename << "'." << endl;
+                return;
+            }
+        }
 
-    void parkVehicle(string licensePlate) {
-        if (parkingLotTower1.getSize() >= capacity) {
-            cout << "Parking lot Tower 1 is full. Cannot park " << licensePlate << "." << endl;
-            return;
+        Graph streamed;
+        EdgeListImporter importer;
+        importer.importFile(filename, streamed);
+        cout << "Streaming importer: " << importer.elapsedMs << " ms, " << importer.megabytesPerSecond() << " MB/s, "
+             << importer.edgesAdded << " roads, " << importer.verticesAdded << " locations" << endl;
+
+        Graph naive;
+        clock_t start = clock();
+        ifstream in(filename.c_str());
+        string line;
+        long long bytes = 0;
+        getline(in, line); // Header
+        while (getline(in, line)) {
+            bytes += line.size() + 1;
+            size_t a = line.find(','), b = line.find(',', a + 1), c = line.find(',', b + 1);
+            int from = stoi(line.substr(0, a)), to = stoi(line.substr(a + 1, b - a - 1));
+            int weight = stoi(line.substr(b + 1, c - b - 1));
+            string name = line.substr(c + 1);
+            if (!naive.findVertex(from)) naive.addVertex(from, name);
+            if (!naive.findVertex(to)) naive.addVertex(to, name);
+            naive.addEdge(from, to, weight);
         }
-        parkingLotTower1.push(licensePlate);
-        cout << "Vehicle " << licensePlate << " parked in Tower 1. Spots left: " << capacity - parkingLotTower1.getSize() << endl;
+        double naiveMs = elapsedMillis(start);
+        cout << "getline + stoi: " << naiveMs << " ms, " << (bytes / (1024.0 * 1024.0)) / (naiveMs / 1000.0) << " MB/s" << endl;
+        cout << "Same graph: " << (naive.numVertices == streamed.numVertices && naive.numEdges == streamed.numEdges ? "yes" : "NO") << endl;
+        remove(filename.c_str());
     }
 
-    void unparkVehicle() {
-        if (parkingLotTower1.isEmpty()) {
-            cout << "Parking lot Tower 1 is empty. No vehicle to unpark." << endl;
-            return;
+    // Startup cost of a 1000x1000 grid (1M locations, ~4M roads): building the linked-list
+    // Graph plus its routing snapshot vs opening the saved binary file
+    static void runNetworkFileBenchmark() {
+        cout << "\n--- Benchmark: opening a binary road network file, 1000000 vertices ---" << endl;
+        const string filename = "routing_benchmark.rnet";
+        double buildMs, loadMs;
+        int checkCost;
+        {
+            clock_t start = clock();
+            Graph grid;
+            buildGridNetwork(grid, 1000, 1000);
+            CSRGraph csr(grid);
+            buildMs = elapsedMillis(start);
+            start = clock();
+            if (!csr.saveToFile(filename)) {
+                cout << "Error: Could not write '" << filename << "'." << endl;
+                return;
+            }
+            cout << "Saved in " << elapsedMillis(start) << " ms" << endl;
+            checkCost = csr.shortestPath(1, 1000000).cost;
         }
-        string unparkedPlate = parkingLotTower1.pop();
-        cout << "Vehicle " << unparkedPlate << " unparked from Tower 1. Spots left: " << capacity - parkingLotTower1.getSize() << endl;
+        CSRGraph loaded;
+        clock_t start = clock();
+        bool ok = loaded.loadFromFile(filename);
+        loadMs = elapsedMillis(start);
+        cout << "Build Graph + snapshot: " << buildMs << " ms" << endl;
+        cout << "Open file: " << loadMs << " ms" << endl;
+        cout << "Same route cost: " << (ok && loaded.shortestPath(1, 1000000).cost == checkCost ? "yes" : "NO") << endl;
+        remove(filename.c_str());
     }
 
-    void displayParkingLotStatus() {
-        cout << "\n--- Parking Lot Tower 1 Status (Capacity: " << capacity << ") ---" << endl;
-        parkingLotTower1.displayStack();
-        cout << "Vehicles Parked: " << parkingLotTower1.getSize() << endl;
-        cout << "Spots Available: " << capacity - parkingLotTower1.getSize() << endl;
+    // 5000 dispatch requests on a 100x100 grid: 90% go to one of 8 hospitals from one of 40
+    // stations, the rest are one-off trips. Repeated with several memory caps.
+    static void runRouteCacheBenchmark() {
+        cout << "\n--- Benchmark: route cache, 5000 dispatch queries on 10000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 100, 100);
+        const int queries = 5000;
+        int* sources = new int[queries];
+        int* targets = new int[queries];
+        SimpleRandom rng(17);
+        for (int q = 0; q < queries; ++q) {
+            if (rng.nextInRange(0, 9) < 9) {
+                sources[q] = rng.nextInRange(0, 39) * 250 + 1;
+                targets[q] = rng.nextInRange(0, 7) * 1250 + 625;
+            } else {
+                sources[q] = rng.nextInRange(1, grid.numVertices);
+                targets[q] = rng.nextInRange(1, grid.numVertices);
+            }
+        }
+        NetworkService service(&grid);
+        service.getRoutingGraph();
+
+        cout << "Cap KB\tms\tHit rate\tEvictions" << endl;
+        long long caps[] = {0, 16, 64, 1024};
+        for (int c = 0; c < 4; ++c) {
+            service.routeCache.clear();
+            service.routeCache.setMaxBytes(caps[c] * 1024);
+            service.routeCache.hits = service.routeCache.misses = service.routeCache.evictions = 0;
+            clock_t start = clock();
+            for (int q = 0; q < queries; ++q) service.route(sources[q], targets[q]);
+            double ms = elapsedMillis(start);
+            cout << caps[c] << "\t" << ms << "\t" << (100.0 * service.routeCache.hits / queries) << "%\t\t" << service.routeCache.evictions << endl;
+        }
+        delete[] sources;
+        delete[] targets;
     }
-};
 
+    // 20 random pairs on a 100x100 grid with K = 16; the latency of each smaller K is the time
+    // until its last route was accepted. Then K = 16 again at 1/2/4/8/16 threads
+    static void runKShortestBenchmark() {
+        cout << "\n--- Benchmark: Yen K shortest loopless routes, 10000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 100, 100);
+        CSRGraph csr(grid);
+        KShortestPaths engine(csr);
+        const int maxK = 16, pairs = 20;
+        RouteResult routes[maxK];
+        double latency[maxK];
+        double latencySum[maxK];
+        for (int i = 0; i < maxK; ++i) latencySum[i] = 0;
+        long long spurSearches = 0;
+        bool ordered = true;
+        SimpleRandom rng(16);
+        for (int q = 0; q < pairs; ++q) {
+            int s = rng.nextInRange(1, csr.numVertices), t = rng.nextInRange(1, csr.numVertices);
+            int found = engine.find(s, t, maxK, routes, latency);
+            spurSearches += engine.spurSearches;
+            for (int i = 0; i < maxK; ++i) latencySum[i] += i < found ? latency[i] : latency[found - 1];
+            for (int i = 1; i < found; ++i) {
+                if (routes[i].cost < routes[i - 1].cost) ordered = false;
+            }
+        }
+        cout << "K\tms/query" << endl;
+        for (int k = 1; k <= maxK; k *= 2) cout << k << "\t" << latencySum[k - 1] / pairs << endl;
+        cout << "Spur searches per query (K=16): " << spurSearches / pairs << endl;
+        cout << "Costs non-decreasing: " << (ordered ? "yes" : "NO") << endl;
+
+        // Same pairs with the spur searches of each round spread over worker threads
+        cout << "\nK=16 with parallel spur searches (" << hardwareThreads() << " hardware thread(s), wall-clock)" << endl;
+        cout << "Threads\tms/query\tSame routes" << endl;
+        int threadCounts[] = {1, 2, 4, 8, 16};
+        for (int i = 0; i < 5; ++i) {
+            KShortestPaths parallelEngine(csr, threadCounts[i]);
+            RouteResult parallelRoutes[maxK];
+            SimpleRandom pairRng(16);
+            bool same = true;
+            double totalMs = 0;
+            for (int q = 0; q < pairs; ++q) {
+                int s = pairRng.nextInRange(1, csr.numVertices), t = pairRng.nextInRange(1, csr.numVertices);
+                int found = engine.find(s, t, maxK, routes);
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                int parallelFound = parallelEngine.find(s, t, maxK, parallelRoutes);
+                totalMs += elapsedWallMillis(start);
+                if (found != parallelFound) same = false;
+                for (int r = 0; same && r < found; ++r) {
+                    if (routes[r].cost != parallelRoutes[r].cost || routes[r].pathLength != parallelRoutes[r].pathLength ||
+                        !sameDistances(routes[r].pathIDs, parallelRoutes[r].pathIDs, routes[r].pathLength)) {
+                        same = false;
+                    }
+                }
+            }
+            cout << threadCounts[i] << "\t" << totalMs / pairs << "\t\t" << (same ? "yes" : "NO") << endl;
+        }
+    }
 
-class UrbanStructure {
-public:
-    NaryTree cityHierarchy;
+    // 2000 stations on a 300x300 grid, budget 150: bounded searches on a stamped workspace vs
+    // full Dijkstra with an O(V) reset per station (filtered to the same budget), then the batch
+    // split over 1/2/4/8/16 workers with one workspace each
+    static void runIsochroneBenchmark() {
+        cout << "\n--- Benchmark: 2000 isochrones (budget 150) on 90000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 300, 300);
+        CSRGraph csr(grid);
+        SearchWorkspace ws(csr.numVertices);
+        const int stations = 2000, budget = 150, checked = 100;
+        int* sources = new int[stations];
+        SimpleRandom rng(8);
+        for (int i = 0; i < stations; ++i) sources[i] = rng.nextInRange(1, csr.numVertices);
+
+        IsochroneSet sets;
+        chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+        csr.isochrones(sources, stations, budget, ws, sets);
+        double boundedMs = elapsedWallMillis(wallStart);
+
+        // Full runs are slow, so only the first 'checked' stations are compared and timed
+        int* dist = new int[csr.numVertices];
+        bool same = true;
+        wallStart = chrono::steady_clock::now();
+        for (int i = 0; i < checked; ++i) {
+            csr.computeDistances(csr.indexOf(sources[i]), dist);
+            int inBudget = 0;
+            for (int v = 0; v < csr.numVertices; ++v) {
+                if (dist[v] <= budget) inBudget++;
+            }
+            if (inBudget != sets.setSize(i)) same = false;
+            for (int k = sets.setOffsets.data[i]; k < sets.setOffsets.data[i + 1]; ++k) {
+                if (dist[csr.indexOf(sets.vertexIDs.data[k])] != sets.costs.data[k]) same = false;
+            }
+        }
+        double fullMs = elapsedWallMillis(wallStart) * stations / checked;
+        cout << "Bounded, stamped workspace: " << boundedMs << " ms total, " << (double)sets.vertexIDs.size / stations << " vertices per set" << endl;
+        cout << "Full Dijkstra (extrapolated from " << checked << "): " << fullMs << " ms total" << endl;
+        cout << "Identical: " << (same ? "yes" : "NO") << endl;
+
+        cout << "\nPer-thread workspaces (" << hardwareThreads() << " hardware thread(s), wall-clock)" << endl;
+        cout << "Threads\tms\tSpeedup\tIdentical" << endl;
+        int threadCounts[] = {1, 2, 4, 8, 16};
+        for (int i = 0; i < 5; ++i) {
+            IsochroneSet parallelSets;
+            wallStart = chrono::steady_clock::now();
+            csr.isochrones(sources, stations, budget, parallelSets, threadCounts[i]);
+            double ms = elapsedWallMillis(wallStart);
+            bool identical = parallelSets.setOffsets.size == sets.setOffsets.size && parallelSets.vertexIDs.size == sets.vertexIDs.size &&
+                             sameDistances(parallelSets.setOffsets.data, sets.setOffsets.data, sets.setOffsets.size) &&
+                             sameDistances(parallelSets.vertexIDs.data, sets.vertexIDs.data, sets.vertexIDs.size) &&
+                             sameDistances(parallelSets.costs.data, sets.costs.data, sets.costs.size);
+            cout << threadCounts[i] << "\t" << ms << "\t" << (ms > 0 ? boundedMs / ms : 0) << "x\t" << (identical ? "yes" : "NO") << endl;
+        }
+        delete[] sources;
+        delete[] dist;
+    }
 
-    UrbanStructure(string cityName) : cityHierarchy(cityName) {}
+    // A 1,000,000-vertex one-way chain (deep enough to overflow a recursive DFS) and a 300x300
+    // grid after closing 40% of its one-way lanes at random, then the union-find WCC on a
+    // 1000x1000 grid with closures at 1/2/4/8/16 threads (wall-clock)
+    static void runConnectivityBenchmark() {
+        cout << "\n--- Benchmark: iterative DFS, Tarjan SCC and union-find WCC ---" << endl;
+        cout << "Network\t\tDFS ms\tReached\tSCC ms\tSCCs\tWCC ms\tWCCs" << endl;
+        for (int network = 0; network < 2; ++network) {
+            Graph graph;
+            if (network == 0) {
+                int n = 1000000;
+                for (int i = 1; i <= n; ++i) graph.addVertex(i, "Chain");
+                for (int i = 1; i < n; ++i) graph.addEdge(i, i + 1, 1);
+            } else {
+                buildGridNetwork(graph, 300, 300);
+                closeRandomLanes(graph, 40, 31);
+            }
+            CSRGraph csr(graph);
+            int* buffer = new int[csr.numVertices];
+            clock_t start = clock();
+            int reached = csr.depthFirstOrder(0, buffer);
+            double dfsMs = elapsedMillis(start);
+            start = clock();
+            int strong = csr.stronglyConnectedComponents(buffer);
+            double sccMs = elapsedMillis(start);
+            start = clock();
+            int weak = csr.weaklyConnectedComponents(buffer);
+            double wccMs = elapsedMillis(start);
+            cout << (network == 0 ? "Chain 1M" : "Grid w/ closures") << "\t" << dfsMs << "\t" << reached << "\t" << sccMs << "\t"
+                 << strong << "\t" << wccMs << "\t" << weak << endl;
+            delete[] buffer;
+        }
 
-    void addDepartment(string parentDept, string newDept) {
-        cityHierarchy.addChild(parentDept, newDept);
-        cout << "Department '" << newDept << "' added under '" << parentDept << "'." << endl;
+        Graph grid;
+        buildGridNetwork(grid, 1000, 1000);
+        closeRandomLanes(grid, 40, 31);
+        CSRGraph csr(grid);
+        int* expected = new int[csr.numVertices];
+        int* labels = new int[csr.numVertices];
+        cout << "\nParallel WCC, 1000x1000 grid w/ closures (" << hardwareThreads() << " hardware thread(s))" << endl;
+        cout << "Threads\tms\tWCCs\tIdentical" << endl;
+        int threadCounts[] = {1, 2, 4, 8, 16};
+        for (int i = 0; i < 5; ++i) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            int weak = csr.weaklyConnectedComponents(i == 0 ? expected : labels, threadCounts[i]);
+            double ms = elapsedWallMillis(start);
+            cout << threadCounts[i] << "\t" << ms << "\t" << weak << "\t" << (i == 0 || sameDistances(labels, expected, csr.numVertices) ? "yes" : "NO") << endl;
+        }
+        delete[] expected;
+        delete[] labels;
     }
 
-    void displayCityHierarchy() {
-        cout << "\n--- City Hierarchy ---" << endl;
-        cityHierarchy.displayTree();
+    // Removes each road of 'graph' with the given percentage chance
+    static void closeRandomLanes(Graph& graph, int percent, unsigned int seed) {
+        SimpleRandom rng(seed);
+        for (int i = 0; i < graph.numVertices; ++i) {
+            GraphVertexNode* v = graph.vertexByIndex[i];
+            GraphEdgeNode* edge = v->adjListHead;
+            while (edge) {
+                GraphEdgeNode* next = edge->next;
+                if (rng.nextInRange(0, 99) < percent) graph.removeEdge(v->id, edge->toVertexID);
+                edge = next;
+            }
+        }
     }
-};
-
-class NetworkService {
-public:
-    Graph* cityGraph; // Reference to the main city graph
 
-    NetworkService(Graph* graph) : cityGraph(graph) {}
+    // Whole-city hop counts: a 300x300 grid (long, thin frontiers) and a 100000-vertex network
+    // with random cross-town links (low diameter, where bottom-up steps pay off). The
+    // direction-optimizing run is repeated at 2/4/8/16 threads; times are wall-clock
+    static void runDirectionOptimizingBFSBenchmark() {
+        cout << "\n--- Benchmark: direction-optimizing BFS vs top-down BFS (" << hardwareThreads() << " hardware thread(s)) ---" << endl;
+        cout << "Network\t\tMode\t\tThreads\tms\tEdges examined\tTD/BU steps\tIdentical" << endl;
+        for (int network = 0; network < 2; ++network) {
+            Graph graph;
+            if (network == 0) {
+                buildGridNetwork(graph, 300, 300);
+            } else {
+                SimpleRandom rng(77);
+                int n = 100000;
+                for (int i = 1; i <= n; ++i) graph.addVertex(i, "Node");
+                for (int e = 0; e < n * 8; ++e) {
+                    int a = rng.nextInRange(1, n), b = rng.nextInRange(1, n);
+                    graph.addEdge(a, b, 1);
+                    graph.addEdge(b, a, 1);
+                }
+            }
+            CSRGraph csr(graph);
+            int* expected = new int[csr.numVertices];
+            int* hops = new int[csr.numVertices];
+            const char* name = network == 0 ? "Grid 300x300" : "Random 100k";
+
+            DirectionOptimizingBFS topDown(csr);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            topDown.computeHops(0, expected, false);
+            cout << name << "\tTop-down\t1\t" << elapsedWallMillis(start) << "\t" << topDown.edgesExamined << "\t\t"
+                 << topDown.topDownSteps << "/" << topDown.bottomUpSteps << "\t\t-" << endl;
+
+            int threadCounts[] = {1, 2, 4, 8, 16};
+            for (int i = 0; i < 5; ++i) {
+                DirectionOptimizingBFS bfs(csr, threadCounts[i]);
+                start = chrono::steady_clock::now();
+                bfs.computeHops(0, hops, true);
+                double ms = elapsedWallMillis(start);
+                bool same = true;
+                for (int v = 0; v < csr.numVertices; ++v) {
+                    if (hops[v] != expected[v]) same = false;
+                }
+                cout << name << "\tDirection-opt\t" << threadCounts[i] << "\t" << ms << "\t" << bfs.edgesExamined << "\t\t"
+                     << bfs.topDownSteps << "/" << bfs.bottomUpSteps << "\t\t" << (same ? "yes" : "NO") << endl;
+            }
+            delete[] expected;
+            delete[] hops;
+        }
+    }
 
-    void findShortestPath(int startID, int endID) { // endID not used in current Dijkstra output
-        if (!cityGraph) {
-            cout << "Error: City graph not initialized for Network Service." << endl;
-            return;
+    // Every road of a 100x100 grid gets a rush-hour profile sampled at 'resolution' breakpoints.
+    // Profiles depend only on the free-flow weight and one of four road classes, so the pool
+    // holds at most 44 of them however many roads there are.
+    static void runTimeDependentBenchmark() {
+        cout << "\n--- Benchmark: time-dependent queries (08:00 departure) vs profile resolution, 10000 vertices ---" << endl;
+        cout << "Points\tProfiles\tPool KB\tTD-Dijkstra ms/query\tTD-A* ms/query\tSame cost" << endl;
+        int resolutions[] = {1, 4, 12, 48, 96, 288};
+        const int queries = 100;
+        for (int r = 0; r < 6; ++r) {
+            int points = resolutions[r];
+            Graph grid;
+            buildGridNetwork(grid, 100, 100);
+            int* minutes = new int[points];
+            int* values = new int[points];
+            for (int i = 0; i < grid.numVertices; ++i) {
+                GraphVertexNode* v = grid.vertexByIndex[i];
+                for (GraphEdgeNode* edge = v->adjListHead; edge; edge = edge->next) {
+                    int roadClass = (v->id + edge->toVertexID) % 4; // Arterial roads suffer most
+                    for (int k = 0; k < points; ++k) {
+                        minutes[k] = k * MINUTES_PER_DAY / points;
+                        values[k] = edge->weight + edge->weight * roadClass * rushHourPercent(minutes[k]) / 100;
+                    }
+                    grid.setEdgeProfile(v->id, edge->toVertexID, grid.profiles.addProfile(minutes, values, points));
+                }
+            }
+            delete[] minutes;
+            delete[] values;
+
+            CSRGraph csr(grid);
+            SearchWorkspace ws(csr.numVertices);
+            SimpleRandom rng(5);
+            double dijkstraMs = 0, aStarMs = 0;
+            bool same = true;
+            for (int q = 0; q < queries; ++q) {
+                int s = rng.nextInRange(1, csr.numVertices), t = rng.nextInRange(1, csr.numVertices);
+                clock_t start = clock();
+                int cost = csr.timeDependentPath(s, t, 480, ws, false).cost;
+                dijkstraMs += elapsedMillis(start);
+                start = clock();
+                if (csr.timeDependentPath(s, t, 480, ws, true).cost != cost) same = false;
+                aStarMs += elapsedMillis(start);
+            }
+            cout << points << "\t" << grid.profiles.numProfiles << "\t\t" << grid.profiles.memoryBytes() / 1024.0 << "\t"
+                 << dijkstraMs / queries << "\t\t\t" << aStarMs / queries << "\t\t" << (same ? "yes" : "NO") << endl;
         }
-        cout << "\n--- Finding Shortest Paths (Dijkstra) ---" << endl;
-        cityGraph->Dijkstra(startID);
     }
 
-    void performBFS(int startID) {
-        if (!cityGraph) {
-            cout << "Error: City graph not initialized for Network Service." << endl;
-            return;
+    // Extra travel time in percent per road class: peaks of 100% at 08:00 and 80% at 17:30,
+    // ramping linearly over two hours on either side (slope well under FIFO's limit)
+    static int rushHourPercent(int minute) {
+        int morning = 120 - (minute > 480 ? minute - 480 : 480 - minute);
+        int evening = 120 - (minute > 1050 ? minute - 1050 : 1050 - minute);
+        int percent = 0;
+        if (morning > 0) percent += morning * 100 / 120;
+        if (evening > 0) percent += evening * 80 / 120;
+        return percent;
+    }
+
+    // 500 random travel-time changes on a 10000-vertex grid, repaired incrementally and checked
+    // against a from-scratch Dijkstra after every update
+    static void runDynamicUpdateBenchmark() {
+        cout << "\n--- Benchmark: incremental shortest-path repair, 500 road updates on 10000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 100, 100);
+        DynamicShortestPathTree incremental(grid, 5050);
+        DynamicShortestPathTree reference(grid, 5050);
+        SimpleRandom rng(11);
+        double incrementalMs = 0, fullMs = 0;
+        long long fullTouched = 0;
+        bool same = true;
+        const int updates = 500;
+        for (int i = 0; i < updates; ++i) {
+            GraphVertexNode* from = grid.vertexByIndex[rng.nextInRange(0, grid.numVertices - 1)];
+            GraphEdgeNode* edge = from->adjListHead;
+            for (int skip = rng.nextInRange(0, 3); skip > 0 && edge->next; --skip) edge = edge->next;
+            int toID = edge->toVertexID;
+            int newWeight = rng.nextInRange(5, 40);
+            int oldWeight = 0;
+            grid.updateEdgeWeight(from->id, toID, newWeight, &oldWeight);
+
+            clock_t start = clock();
+            incremental.edgeWeightChanged(from->id, toID, oldWeight, newWeight);
+            incrementalMs += elapsedMillis(start);
+
+            start = clock();
+            reference.recompute();
+            fullMs += elapsedMillis(start);
+            fullTouched += reference.touchedLastUpdate;
+
+            for (int v = 0; v < grid.numVertices; ++v) {
+                if (incremental.dist[v] != reference.dist[v]) same = false;
+            }
         }
-        cout << "\n--- Performing BFS ---" << endl;
-        cityGraph->BFS(startID);
+        cout << "Method\t\tTotal ms\tAvg vertices touched" << endl;
+        cout << "Incremental\t" << incrementalMs << "\t\t" << (double)incremental.totalTouched / updates << endl;
+        cout << "Full Dijkstra\t" << fullMs << "\t\t" << (double)fullTouched / updates << endl;
+        cout << "Identical: " << (same ? "yes" : "NO") << endl;
     }
-    
-    void performDFS(int startID) {
-        if (!cityGraph) {
-            cout << "Error: City graph not initialized for Network Service." << endl;
-            return;
+
+    // 100 depots x 1000 stops: per-source early-stopping Dijkstra vs contraction hierarchy buckets
+    static void runDistanceMatrixBenchmark() {
+        cout << "\n--- Benchmark: 100 x 1000 distance matrix on 10000 vertices ---" << endl;
+        Graph grid;
+        buildGridNetwork(grid, 100, 100);
+        CSRGraph csr(grid);
+        SearchWorkspace ws(csr.numVertices);
+        const int numSources = 100, numTargets = 1000;
+        int* sources = new int[numSources];
+        int* targets = new int[numTargets];
+        SimpleRandom rng(19);
+        for (int i = 0; i < numSources; ++i) sources[i] = rng.nextInRange(1, csr.numVertices);
+        for (int j = 0; j < numTargets; ++j) targets[j] = rng.nextInRange(1, csr.numVertices);
+
+        clock_t start = clock();
+        DistanceMatrix plain = csr.distanceMatrix(sources, numSources, targets, numTargets, ws);
+        cout << "Per-source Dijkstra: " << elapsedMillis(start) << " ms" << endl;
+
+        start = clock();
+        ContractionHierarchy ch;
+        ch.build(csr);
+        cout << "Hierarchy preprocessing: " << elapsedMillis(start) << " ms" << endl;
+
+        start = clock();
+        DistanceMatrix buckets = ch.distanceMatrix(sources, numSources, targets, numTargets, ws);
+        cout << "Hierarchy buckets: " << elapsedMillis(start) << " ms" << endl;
+
+        bool same = true;
+        for (int i = 0; i < numSources * numTargets; ++i) {
+            if (plain.values[i] != buckets.values[i]) same = false;
         }
-        cout << "\n--- Performing DFS ---" << endl;
-        cityGraph->DFS(startID);
+        cout << "Identical: " << (same ? "yes" : "NO") << endl;
+        delete[] sources;
+        delete[] targets;
     }
 };
 
@@ -1000,12 +8576,13 @@ public:
         structureModule.addDepartment("Dinas Perhubungan", "Seksi Parkir");
 
         // Road Network (Vertices are locations/intersections)
-        cityRoadNetwork.addVertex(1, "Simpang A");
-        cityRoadNetwork.addVertex(2, "Simpang B");
-        cityRoadNetwork.addVertex(3, "Kantor Walikota");
-        cityRoadNetwork.addVertex(4, "Pasar Sentral");
-        cityRoadNetwork.addVertex(5, "Rumah Sakit Umum");
-        cityRoadNetwork.addVertex(6, "Area Parkir Pusat");
+        // Coordinates are on a rough 1-unit-per-minute map, used by A*
+        cityRoadNetwork.addVertex(1, "Simpang A", 0, 0);
+        cityRoadNetwork.addVertex(2, "Simpang B", 5, 0);
+        cityRoadNetwork.addVertex(3, "Kantor Walikota", 11, 3);
+        cityRoadNetwork.addVertex(4, "Pasar Sentral", 1, 3);
+        cityRoadNetwork.addVertex(5, "Rumah Sakit Umum", 5, 4);
+        cityRoadNetwork.addVertex(6, "Area Parkir Pusat", 8, 3);
 
 
         // Roads (Edges) - (from, to, weight/distance)
@@ -1024,6 +8601,17 @@ public:
         cityRoadNetwork.addEdge(4, 6, 4); // Pasar -> Parkir Pusat
         cityRoadNetwork.addEdge(6, 4, 4);
 
+        // Rush hours (07:00-09:30 and 17:00-19:30) on the corridor through Simpang B;
+        // the constant weights above stay the free-flow times used by the static engines
+        int rushMinutes[] = {0, 420, 480, 570, 1020, 1080, 1170};
+        int rushAB[] = {5, 5, 12, 5, 5, 10, 5};
+        int rushBK[] = {7, 7, 15, 7, 7, 13, 7};
+        int profileAB = cityRoadNetwork.profiles.addProfile(rushMinutes, rushAB, 7);
+        int profileBK = cityRoadNetwork.profiles.addProfile(rushMinutes, rushBK, 7);
+        cityRoadNetwork.setEdgeProfile(1, 2, profileAB);
+        cityRoadNetwork.setEdgeProfile(2, 1, profileAB);
+        cityRoadNetwork.setEdgeProfile(2, 3, profileBK);
+        cityRoadNetwork.setEdgeProfile(3, 2, profileBK);
 
         cout << "Default data initialization complete." << endl;
     }
@@ -1049,6 +8637,7 @@ public:
             cout << "2. Find Citizen by ID" << endl;
             cout << "3. Display All Citizens" << endl;
             cout << "4. Suggest Citizen Names (Trie)" << endl;
+            cout << "5. Remove Citizen by ID" << endl;
             cout << "0. Back to Main Menu" << endl;
             cout << "Enter choice: ";
             cin >> choice;
@@ -1075,6 +8664,10 @@ public:
                     cout << "Enter name prefix for suggestions: "; getline(cin, prefix);
                     citizenModule.suggestCitizenNames(prefix);
                     break;
+                case 5:
+                    cout << "Enter ID to remove: "; cin >> id; cin.ignore();
+                    citizenModule.deleteCitizen(id);
+                    break;
                 case 0: break;
                 default: cout << "Invalid choice. Try again." << endl;
             }
@@ -1176,16 +8769,42 @@ public:
     void networkMenu() {
         int choice;
         do {
+            networkModule.runIdleMaintenance();
             cout << "\n--- Network Services Menu ---" << endl;
             cout << "1. Display Road Network (Graph)" << endl;
             cout << "2. Find Shortest Paths from Location (Dijkstra)" << endl;
             cout << "3. Perform BFS Traversal from Location" << endl;
             cout << "4. Perform DFS Traversal from Location" << endl;
+            cout << "5. Find Route Between Two Locations" << endl;
+            cout << "6. Select Routing Engine (current: " << networkModule.engineName() << ")" << endl;
+            cout << "7. Save Contraction Hierarchy to File" << endl;
+            cout << "8. Load Contraction Hierarchy from File" << endl;
+            cout << "9. Routing Benchmarks" << endl;
+            cout << "10. Distance Matrix Between Locations" << endl;
+            cout << "11. Update Road Travel Time" << endl;
+            cout << "12. Find Route at Departure Time (rush hour aware)" << endl;
+            cout << "13. Hop-count Reachability from Location" << endl;
+            cout << "14. Close Road" << endl;
+            cout << "15. Connectivity and Island Report" << endl;
+            cout << "16. Locations Reachable Within Time Budget" << endl;
+            cout << "17. Find K Alternative Routes" << endl;
+            cout << "18. Route Cache Statistics" << endl;
+            cout << "19. Set Route Cache Memory Cap" << endl;
+            cout << "20. Save Road Network to Binary File" << endl;
+            cout << "21. Open Road Network File for Routing" << endl;
+            cout << "22. Import Roads from Edge List (from,to,weight[,name])" << endl;
+            cout << "23. Rank Critical Intersections (betweenness)" << endl;
+            cout << "24. Routing Snapshot Versions" << endl;
+            cout << "25. Plan Utility Network (minimum spanning tree)" << endl;
+            cout << "26. Set Road Capacity" << endl;
+            cout << "27. Plan Evacuation to Shelters (min-cost flow)" << endl;
+            cout << "28. Set Worker Threads for Parallel Engines" << endl;
             cout << "0. Back to Main Menu" << endl;
             cout << "Enter choice: ";
             cin >> choice;
             cin.ignore();
-            int startID;
+            int startID, endID, weight, departure;
+            string filename;
             switch (choice) {
                 case 1:
                     cityRoadNetwork.displayGraph();
@@ -1202,7 +8821,303 @@ public:
                     cout << "Enter Start Location ID for DFS: "; cin >> startID; cin.ignore();
                     networkModule.performDFS(startID);
                     break;
+                case 5:
+                    cout << "Enter Start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter Destination Location ID: "; cin >> endID; cin.ignore();
+                    networkModule.findShortestPath(startID, endID);
+                    break;
+                case 6:
+                    engineMenu();
+                    break;
+                case 7:
+                    cout << "Enter file name: "; getline(cin, filename);
+                    networkModule.saveHierarchy(filename);
+                    break;
+                case 8:
+                    cout << "Enter file name: "; getline(cin, filename);
+                    networkModule.loadHierarchy(filename);
+                    break;
+                case 9:
+                    benchmarkMenu();
+                    break;
+                case 10:
+                    distanceMatrixPrompt();
+                    break;
+                case 11:
+                    cout << "Enter road start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter road end Location ID: "; cin >> endID; cin.ignore();
+                    cout << "Enter new travel time: "; cin >> weight; cin.ignore();
+                    networkModule.updateRoadTravelTime(startID, endID, weight);
+                    break;
+                case 12:
+                    cout << "Enter Start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter Destination Location ID: "; cin >> endID; cin.ignore();
+                    cout << "Enter departure time (minutes after midnight, e.g. 480 = 08:00): "; cin >> departure; cin.ignore();
+                    networkModule.findTimeDependentRoute(startID, endID, departure);
+                    break;
+                case 13:
+                    cout << "Enter Start Location ID: "; cin >> startID; cin.ignore();
+                    networkModule.hopReachability(startID);
+                    break;
+                case 14:
+                    cout << "Enter road start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter road end Location ID: "; cin >> endID; cin.ignore();
+                    networkModule.closeRoad(startID, endID);
+                    break;
+                case 15:
+                    networkModule.connectivityReport();
+                    break;
+                case 16:
+                    cout << "Enter station Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter time budget: "; cin >> weight; cin.ignore();
+                    networkModule.reachableWithin(startID, weight);
+                    break;
+                case 17:
+                    cout << "Enter Start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter Destination Location ID: "; cin >> endID; cin.ignore();
+                    cout << "Enter number of routes (K): "; cin >> weight; cin.ignore();
+                    networkModule.alternativeRoutes(startID, endID, weight);
+                    break;
+                case 18:
+                    cout << "\n--- Route Cache ---" << endl;
+                    networkModule.routeCache.printStats();
+                    break;
+                case 19:
+                    cout << "Enter memory cap in KB: "; cin >> weight; cin.ignore();
+                    if (weight < 0) {
+                        cout << "Memory cap cannot be negative." << endl;
+                        break;
+                    }
+                    networkModule.routeCache.setMaxBytes(weight * 1024LL);
+                    networkModule.routeCache.printStats();
+                    break;
+                case 20:
+                    cout << "Enter file name: "; getline(cin, filename);
+                    networkModule.saveNetwork(filename);
+                    break;
+                case 21:
+                    cout << "Enter file name (- for the live city graph): "; getline(cin, filename);
+                    networkModule.openNetwork(filename);
+                    break;
+                case 22:
+                    cout << "Enter file name: "; getline(cin, filename);
+                    networkModule.importEdgeList(filename);
+                    break;
+                case 23:
+                    cout << "How many locations to list: "; cin >> endID; cin.ignore();
+                    cout << "Sample sources (0 for exact): "; cin >> weight; cin.ignore();
+                    networkModule.rankCriticalIntersections(endID, weight);
+                    break;
+                case 24:
+                    networkModule.getRoutingGraph();
+                    cout << "\n--- Routing Snapshots ---" << endl;
+                    networkModule.snapshots.printStats();
+                    break;
+                case 25:
+                    cout << "Center Location ID (0 for the whole city): "; cin >> startID; cin.ignore();
+                    weight = 0;
+                    if (startID != 0) {
+                        cout << "Travel-time radius: "; cin >> weight; cin.ignore();
+                    }
+                    networkModule.planUtilityNetwork(startID, weight);
+                    break;
+                case 26:
+                    cout << "Enter road start Location ID: "; cin >> startID; cin.ignore();
+                    cout << "Enter road end Location ID: "; cin >> endID; cin.ignore();
+                    cout << "Enter capacity (people, 0 closes it to evacuation traffic): "; cin >> weight; cin.ignore();
+                    if (cityRoadNetwork.setEdgeCapacity(startID, endID, weight)) cout << "Capacity of road " << startID << " -> " << endID << " set to " << weight << "." << endl;
+                    else cout << "Error: No road from " << startID << " to " << endID << " (or negative capacity)." << endl;
+                    break;
+                case 27:
+                    evacuationPrompt();
+                    break;
+                case 28:
+                    cout << "Enter number of threads: "; cin >> weight; cin.ignore();
+                    networkModule.setWorkerThreads(weight);
+                    break;
+
+                case 0: break;
+                default: cout << "Invalid choice. Try again." << endl;
+            }
+        } while (choice != 0);
+    }
+
+    void distanceMatrixPrompt() {
+        int numSources, numTargets;
+        cout << "Number of origin locations: "; cin >> numSources; cin.ignore();
+        cout << "Number of destination locations: "; cin >> numTargets; cin.ignore();
+        if (numSources <= 0 || numTargets <= 0) {
+            cout << "Both counts must be positive." << endl;
+            return;
+        }
+        int* sources = new int[numSources];
+        int* targets = new int[numTargets];
+        cout << "Enter " << numSources << " origin IDs: ";
+        for (int i = 0; i < numSources; ++i) cin >> sources[i];
+        cout << "Enter " << numTargets << " destination IDs: ";
+        for (int j = 0; j < numTargets; ++j) cin >> targets[j];
+        cin.ignore();
+        networkModule.printDistanceMatrix(sources, numSources, targets, numTargets);
+        delete[] sources;
+        delete[] targets;
+    }
+
+    void evacuationPrompt() {
+        int numDistricts, numShelters;
+        cout << "Number of districts to evacuate: "; cin >> numDistricts; cin.ignore();
+        cout << "Number of shelters: "; cin >> numShelters; cin.ignore();
+        if (numDistricts <= 0 || numShelters <= 0) {
+            cout << "Both counts must be positive." << endl;
+            return;
+        }
+        int* districts = new int[numDistricts];
+        int* populations = new int[numDistricts];
+        int* shelters = new int[numShelters];
+        int* capacities = new int[numShelters];
+        cout << "Enter " << numDistricts << " pairs of district ID and population: ";
+        for (int i = 0; i < numDistricts; ++i) cin >> districts[i] >> populations[i];
+        cout << "Enter " << numShelters << " pairs of shelter ID and capacity: ";
+        for (int i = 0; i < numShelters; ++i) cin >> shelters[i] >> capacities[i];
+        cin.ignore();
+        networkModule.planEvacuation(districts, populations, numDistricts, shelters, capacities, numShelters);
+        delete[] districts;
+        delete[] populations;
+        delete[] shelters;
+        delete[] capacities;
+    }
+
+    void engineMenu() {
+        int choice;
+        cout << "\n--- Routing Engines ---" << endl;
+        cout << "1. Dijkstra" << endl;
+        cout << "2. A* (straight-line heuristic)" << endl;
+        cout << "3. Bidirectional Dijkstra" << endl;
+        cout << "4. Contraction Hierarchies (preprocessed)" << endl;
+        cout << "5. ALT (landmarks + triangle inequality)" << endl;
+        cout << "6. District Overlay (partitioned cells, CRP-style)" << endl;
+        cout << "Enter choice: ";
+        cin >> choice;
+        cin.ignore();
+        switch (choice) {
+            case 1: networkModule.setEngine(ENGINE_DIJKSTRA); break;
+            case 2: networkModule.setEngine(ENGINE_ASTAR); break;
+            case 3: networkModule.setEngine(ENGINE_BIDIRECTIONAL); break;
+            case 4: networkModule.setEngine(ENGINE_CONTRACTION_HIERARCHY); break;
+            case 5: networkModule.setEngine(ENGINE_ALT); break;
+            case 6: networkModule.setEngine(ENGINE_OVERLAY); break;
+            default: cout << "Invalid choice. Engine unchanged." << endl;
+        }
+    }
 
+    void benchmarkMenu() {
+        int choice;
+        do {
+            cout << "\n--- Routing Benchmarks Menu ---" << endl;
+            cout << "1. Dijkstra Priority Queues vs Vertex Count" << endl;
+            cout << "2. Linked-list Graph vs CSR Snapshot" << endl;
+            cout << "3. Bulk Graph Loading" << endl;
+            cout << "4. Full Dijkstra vs Point-to-Point Query" << endl;
+            cout << "5. Dijkstra vs A* (settled vertices)" << endl;
+            cout << "6. Dijkstra vs Bidirectional Dijkstra" << endl;
+            cout << "7. Contraction Hierarchies" << endl;
+            cout << "8. A* vs ALT (landmarks)" << endl;
+            cout << "9. Delta-stepping Bucket Widths" << endl;
+            cout << "10. Many-to-many Distance Matrix" << endl;
+            cout << "11. Incremental Updates vs Full Recomputation" << endl;
+            cout << "12. Time-dependent Queries vs Profile Resolution" << endl;
+            cout << "13. Direction-optimizing BFS vs Top-down BFS" << endl;
+            cout << "14. Iterative DFS and Connected Components" << endl;
+            cout << "15. Batched Isochrones" << endl;
+            cout << "16. K Shortest Routes Latency per K" << endl;
+            cout << "17. Route Cache under a Dispatch Workload" << endl;
+            cout << "18. Binary Network File vs Rebuilding the Graph" << endl;
+            cout << "19. Streaming Edge-list Import Throughput" << endl;
+            cout << "20. Betweenness Centrality: Exact vs Sampled" << endl;
+            cout << "21. Pinned Routing Snapshots during Road Edits" << endl;
+            cout << "22. District Overlay (CRP-style) vs Dijkstra" << endl;
+            cout << "23. Minimum Spanning Tree: Boruvka vs Kruskal" << endl;
+            cout << "24. Min-cost Flow Evacuation: Paths vs Blocking Flow per Phase" << endl;
+            cout << "25. Citizen Registry: Hashed ID Index vs Linear Scan" << endl;
+            cout << "0. Back to Network Services Menu" << endl;
+            cout << "Enter choice: ";
+            cin >> choice;
+            cin.ignore();
+            switch (choice) {
+                case 1:
+                    RoutingBenchmark::runPriorityQueueBenchmark();
+                    break;
+                case 2:
+                    RoutingBenchmark::runCSRBenchmark();
+                    break;
+                case 3:
+                    RoutingBenchmark::runGraphLoadBenchmark();
+                    break;
+                case 4:
+                    RoutingBenchmark::runPointToPointBenchmark();
+                    break;
+                case 5:
+                    RoutingBenchmark::runAStarBenchmark();
+                    break;
+                case 6:
+                    RoutingBenchmark::runBidirectionalBenchmark();
+                    break;
+                case 7:
+                    RoutingBenchmark::runContractionHierarchyBenchmark();
+                    break;
+                case 8:
+                    RoutingBenchmark::runLandmarkBenchmark();
+                    break;
+                case 9:
+                    RoutingBenchmark::runDeltaSteppingBenchmark();
+                    break;
+                case 10:
+                    RoutingBenchmark::runDistanceMatrixBenchmark();
+                    break;
+                case 11:
+                    RoutingBenchmark::runDynamicUpdateBenchmark();
+                    break;
+                case 12:
+                    RoutingBenchmark::runTimeDependentBenchmark();
+                    break;
+                case 13:
+                    RoutingBenchmark::runDirectionOptimizingBFSBenchmark();
+                    break;
+                case 14:
+                    RoutingBenchmark::runConnectivityBenchmark();
+                    break;
+                case 15:
+                    RoutingBenchmark::runIsochroneBenchmark();
+                    break;
+                case 16:
+                    RoutingBenchmark::runKShortestBenchmark();
+                    break;
+                case 17:
+                    RoutingBenchmark::runRouteCacheBenchmark();
+                    break;
+                case 18:
+                    RoutingBenchmark::runNetworkFileBenchmark();
+                    break;
+                case 19:
+                    RoutingBenchmark::runEdgeListImportBenchmark();
+                    break;
+                case 20:
+                    RoutingBenchmark::runBetweennessBenchmark();
+                    break;
+                case 21:
+                    RoutingBenchmark::runSnapshotBenchmark();
+                    break;
+                case 22:
+                    RoutingBenchmark::runOverlayBenchmark();
+                    break;
+                case 23:
+                    RoutingBenchmark::runSpanningTreeBenchmark();
+                    break;
+                case 24:
+                    RoutingBenchmark::runEvacuationBenchmark();
+                    break;
+                case 25:
+                    RoutingBenchmark::runCitizenIndexBenchmark();
+                    break;
                 case 0: break;
                 default: cout << "Invalid choice. Try again." << endl;
             }
@@ -1213,6 +9128,7 @@ public:
     void run() {
         int choice;
         do {
+            networkModule.runIdleMaintenance();
             displayMainMenu();
             cin >> choice;
             cin.ignore(); // consume the newline character after reading integer